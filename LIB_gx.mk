@@ -11,11 +11,13 @@
 
 LIB_gx = libgx
 LIB_gx.SRC =\
-  Camera.cc DrawContext2D.cc DrawContext3D.cc Font.cc Gui.cc Image.cc\
-  Logger.cc OpenGL.cc OpenGLRenderer.cc Random.cc Renderer.cc\
-  TextFormat.cc TextMetaState.cc ThreadID.cc Unicode.cc Window.cc\
-  glfw/Clipboard.cc glfw/GLFW.cc glfw/WindowImpl.cc\
-  3rd/glad_gl.c 3rd/stb_image.c
+  AtlasPacker.cc Camera.cc DrawContext2D.cc DrawContext3D.cc DrawList.cc\
+  Font.cc FontAtlas.cc Gui.cc Image.cc Logger.cc OpenGL.cc\
+  OpenGLRenderer.cc Path.cc Random.cc Renderer.cc TextBuffer.cc\
+  TextFormat.cc TextLayoutCache.cc TextMetaState.cc ThreadID.cc\
+  Unicode.cc Window.cc\
+  glfw/Clipboard.cc glfw/GLFW.cc glfw/WindowImpl.cc 3rd/glad_gl.c\
+  3rd/stb_image.c
 
 LIB_gx.LIBS = -
 WINDOWS.LIB_gx.LIBS = Dwmapi
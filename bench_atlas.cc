@@ -0,0 +1,131 @@
+//
+// bench_atlas.cc
+// Copyright (C) 2026 Richard Bradley
+//
+// Font atlas packing benchmark (no window/renderer needed)
+// - packs glyphs of bundled fonts w/ previous fixed row packing & with
+//   AtlasPacker, reports texture size & packing efficiency
+//   (glyph pixels / texture pixels)
+//
+
+#include "gx/AtlasPacker.hh"
+#include "gx/Font.hh"
+#include "gx/Time.hh"
+#include "gx/Print.hh"
+#include "gx/CmdLineParser.hh"
+#include <vector>
+#include <algorithm>
+
+using gx::println;
+using gx::println_err;
+
+
+// **** Constants ****
+constexpr const char* FONT_FILES[] = {
+  "data/FreeSans.ttf",
+  "data/FreeSansBold.ttf",
+  "data/LiberationSans-Regular.ttf",
+  "data/LiberationSans-Bold.ttf",
+  "data/LiberationMono-Regular.ttf",
+  "data/LiberationMono-Bold.ttf",
+  "data/MaterialIcons-Regular.ttf",
+  "data/DroidSansJapanese.ttf"
+};
+constexpr int FONT_SIZES[] = { 16, 32, 64 };
+constexpr int MAX_TEXTURE_SIZE = 16384;
+
+
+// **** Benchmark ****
+struct Result {
+  int width = 0, height = 0;
+  int64_t usec = 0;
+};
+
+Result rowPacking(const std::vector<gx::AtlasPacker::Item>& items)
+{
+  // fixed height rows (max glyph height), grown until width <= 2*height
+  const int64_t t0 = gx::usecTime();
+  int maxW = 0, maxH = 0, totalW = 0;
+  for (const auto& i : items) {
+    maxW = std::max(maxW, i.width);
+    maxH = std::max(maxH, i.height);
+    totalW += i.width + 1;
+  }
+
+  int texW, texH;
+  int rows = 0;
+  do {
+    ++rows;
+    texW = maxW + 1 + (totalW / rows);
+    texH = ((maxH + 1) * rows) + 1;
+  } while ((texW > texH*2) || (texW > MAX_TEXTURE_SIZE));
+
+  // check glyph placement to get actual height used
+  int x = 1, y = 1;
+  for (const auto& i : items) {
+    if (i.width == 0) { continue; }
+    if ((x + i.width) >= texW) { x = 1; y += maxH + 1; }
+    x += i.width + 1;
+  }
+  texH = std::max(texH, y + maxH + 1);
+
+  if (texW & 15) { texW = (texW & ~15) + 16; }
+  if (texH & 15) { texH = (texH & ~15) + 16; }
+  return {texW, texH, gx::usecTime() - t0};
+}
+
+Result packerPacking(std::vector<gx::AtlasPacker::Item>& items)
+{
+  const int64_t t0 = gx::usecTime();
+  gx::AtlasPacker p;
+  if (!p.packAll(items, MAX_TEXTURE_SIZE, 1)) { return {}; }
+  return {p.width(), p.height(), gx::usecTime() - t0};
+}
+
+void report(const char* name, const Result& r, int64_t glyphArea)
+{
+  const double area = double(r.width) * double(r.height);
+  println("  ", name, r.width, "x", r.height, "  ",
+          (area > 0) ? double(glyphArea) * 100.0 / area : 0.0, "% used  (",
+          r.usec, " usec)");
+}
+
+int main(int argc, char** argv)
+{
+  for (gx::CmdLineParser p{argc, argv}; p; ++p) {
+    println_err("usage: ", argv[0]);
+    return -1;
+  }
+
+  double rowTotal = 0, packerTotal = 0;
+  int64_t glyphTotal = 0;
+  for (const char* file : FONT_FILES) {
+    for (const int size : FONT_SIZES) {
+      gx::Font fnt{size};
+      if (!fnt.load(file)) {
+        println_err("ERROR: can't load font '", file, "'");
+        return -1;
+      }
+
+      std::vector<gx::AtlasPacker::Item> items;
+      int64_t glyphArea = 0;
+      for (const gx::Glyph& g : fnt.glyphs()) {
+        items.push_back({g.width, g.height});
+        glyphArea += int64_t(g.width) * int64_t(g.height);
+      }
+
+      println(file, " (", size, "px, ", items.size(), " glyphs)");
+      const Result r0 = rowPacking(items);
+      const Result r1 = packerPacking(items);
+      report("rows:        ", r0, glyphArea);
+      report("AtlasPacker: ", r1, glyphArea);
+      rowTotal += double(r0.width) * double(r0.height);
+      packerTotal += double(r1.width) * double(r1.height);
+      glyphTotal += glyphArea;
+    }
+  }
+
+  println("total used:  rows ", double(glyphTotal) * 100.0 / rowTotal,
+          "%, AtlasPacker ", double(glyphTotal) * 100.0 / packerTotal, "%");
+  return 0;
+}
@@ -0,0 +1,109 @@
+//
+// bench_draw.cc
+// Copyright (C) 2026 Richard Bradley
+//
+// DrawContext2D benchmark (headless, no window/renderer needed)
+// - draws GUI-style shapes (rounded panels, buttons, borders, circles)
+//   into a DrawList and reports average time per redraw
+// - draws Style shapes w/ & w/o a ShapeCache
+//
+
+#include "gx/DrawContext2D.hh"
+#include "gx/DrawList.hh"
+#include "gx/ShapeCache.hh"
+#include "gx/Style.hh"
+#include "gx/Time.hh"
+#include "gx/Print.hh"
+#include "gx/CmdLineParser.hh"
+
+using gx::println;
+using gx::println_err;
+
+
+// **** Constants ****
+constexpr int DEFAULT_FRAMES = 200;
+constexpr int ELEMS = 2000;  // GUI elements per frame
+
+
+void drawFrame(gx::DrawContext2D& dc)
+{
+  constexpr auto PANEL = gx::packRGBA8(.2f, .2f, .3f, 1.0f);
+  constexpr auto BUTTON = gx::packRGBA8(.3f, .3f, .6f, 1.0f);
+  constexpr auto EDGE = gx::packRGBA8(.8f, .8f, .8f, 1.0f);
+  constexpr auto EDGE2 = gx::packRGBA8(.4f, .4f, .4f, 1.0f);
+
+  dc.clearList();
+  for (int i = 0; i < ELEMS; ++i) {
+    const float x = float((i % 40) * 30);
+    const float y = float((i / 40) * 16);
+    const gx::Rect r{x, y, 28, 14};
+
+    dc.color(i & 1 ? PANEL : BUTTON);
+    dc.roundedRectangle(r, 4, 4);
+    dc.color(EDGE);
+    dc.roundedBorder(r, 4, 4, 1);
+    dc.roundedBorderShaded(r, 5, 4, 1, EDGE, EDGE2, 0);
+    if ((i % 8) == 0) {
+      dc.circle({x + 7, y + 7}, 5, 16);
+      dc.arc({x + 21, y + 7}, 5, 45, 270, 12, 1);
+    }
+  }
+}
+
+void drawShapes(gx::DrawContext2D& dc, const gx::Style& s1,
+                const gx::Style& s2)
+{
+  dc.clearList();
+  for (int i = 0; i < ELEMS; ++i) {
+    const gx::Rect r{float((i % 40) * 30), float((i / 40) * 16), 28, 14};
+    dc.shape(r, (i & 1) ? s1 : s2);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int frames = DEFAULT_FRAMES;
+  for (gx::CmdLineParser p{argc, argv}; p; ++p) {
+    if (p.option() || !p.get(frames) || frames < 1) {
+      println_err("usage: ", argv[0], " [frames]");
+      return -1;
+    }
+  }
+
+  gx::DrawList dl;
+  gx::DrawContext2D dc{dl};
+
+  drawFrame(dc); // warm up
+
+  const int64_t t0 = gx::usecTime();
+  for (int f = 0; f < frames; ++f) { drawFrame(dc); }
+  const int64_t t1 = gx::usecTime();
+
+  const double usec = double(t1 - t0) / double(frames);
+  println(ELEMS, " elements x ", frames, " frames");
+  println("avg redraw: ", usec, " usec  (", dl.size(), " values)");
+
+  // GUI theme style shapes
+  gx::Style s1;
+  s1.fillColor = gx::packRGBA8(.3f, .3f, .6f, 1.0f);
+  s1.edgeColor = gx::packRGBA8(.8f, .8f, .8f, 1.0f);
+  s1.cornerRadius = 4;
+  s1.cornerSegments = 4;
+  gx::Style s2 = s1;
+  s2.fill = gx::Style::vgradient;
+  s2.fillColor2 = gx::packRGBA8(.2f, .2f, .3f, 1.0f);
+
+  gx::ShapeCache cache;
+  gx::ShapeCache* caches[] = {nullptr, &cache};
+  for (gx::ShapeCache* c : caches) {
+    dc.shapeCache(c);
+    drawShapes(dc, s1, s2); // warm up
+    const int64_t st0 = gx::usecTime();
+    for (int f = 0; f < frames; ++f) { drawShapes(dc, s1, s2); }
+    const int64_t st1 = gx::usecTime();
+    println(c ? "shape (cached):   " : "shape (uncached): ",
+            double(st1 - st0) / double(frames), " usec  (", dl.size(),
+            " values)");
+  }
+  return 0;
+}
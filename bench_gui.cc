@@ -0,0 +1,119 @@
+//
+// bench_gui.cc
+// Copyright (C) 2026 Richard Bradley
+//
+// Gui benchmark (headless, no window/renderer needed)
+// - times panel creation
+// - builds a large GUI & times element lookups/value updates
+//
+
+#include "gx/Gui.hh"
+#include "gx/GuiBuilder.hh"
+#include "gx/GuiTheme.hh"
+#include "gx/Font.hh"
+#include "gx/Time.hh"
+#include "gx/Print.hh"
+#include "gx/CmdLineParser.hh"
+#include <string>
+
+using gx::println;
+using gx::println_err;
+
+
+// **** Constants ****
+constexpr const char* FONT_FILE = "data/FreeSans.ttf";
+constexpr int DEFAULT_ELEMS = 5000;
+constexpr int PANELS = 20;
+constexpr int UPDATES = 200000;
+constexpr int CREATES = 20000;
+
+
+int main(int argc, char** argv)
+{
+  int elems = DEFAULT_ELEMS;
+  for (gx::CmdLineParser p{argc, argv}; p; ++p) {
+    if (p.option() || !p.get(elems) || elems < PANELS) {
+      println_err("usage: ", argv[0], " [elements]");
+      return -1;
+    }
+  }
+
+  gx::Font fnt{20};
+  if (!fnt.load(FONT_FILE)) {
+    println_err("ERROR: can't load font '", FONT_FILE, "'");
+    return -1;
+  }
+
+  gx::GuiTheme theme{&fnt};
+  gx::Gui gui;
+
+  // panel creation (builder functions, layout & indexing)
+  int64_t t0 = gx::usecTime();
+  for (int i = 0; i < CREATES; ++i) {
+    gui.newPanel(theme, 0, 0, gx::Align::top_left, 0,
+      gx::guiVFrame(
+        gx::guiHFrame(gx::guiButton(1, "Button"),
+                      gx::guiCheckbox(2, false, "Checkbox"),
+                      gx::guiLabel("Label")),
+        gx::guiMenu(3, "Menu", gx::guiMenuItem(1, "Item 1"),
+                    gx::guiMenuItem(2, "Item 2"), gx::guiMenuItem(3, "Item 3")),
+        gx::guiHFrame(gx::guiLabel("Entry:"), gx::guiTextEntry(4, 16, 64))));
+    gui.clear();
+  }
+  int64_t t1 = gx::usecTime();
+  println("newPanel:        ",
+          double(t1 - t0) / CREATES, " usec/panel");
+
+  const int perPanel = elems / PANELS;
+  for (int p = 0; p < PANELS; ++p) {
+    gx::GuiElem frame = gx::guiVFrame();
+    frame.elems.reserve(std::size_t(perPanel));
+    for (int i = 0; i < perPanel; ++i) {
+      const gx::EventID eid = (p * perPanel) + i + 1;
+      if (i & 1) {
+        frame.elems.push_back(
+          gx::guiCheckbox(eid, false, gx::guiLabel("check")));
+      } else {
+        frame.elems.push_back(gx::guiLabel(eid, "label"));
+      }
+    }
+    gui.newPanel(theme, 0, 0, gx::Align::top_left, 0, std::move(frame));
+  }
+
+  const int total = perPanel * PANELS;
+  const std::string txt = "value";
+
+  // setText() w/ panel ID
+  t0 = gx::usecTime();
+  for (int i = 0; i < UPDATES; ++i) {
+    const int no = (i * 2) % total;
+    gui.setText((no / perPanel) + 1, no + 1, txt);
+  }
+  t1 = gx::usecTime();
+  println(total, " elements, ", UPDATES, " updates");
+  println("setText(pid):    ",
+          double(t1 - t0) * 1000.0 / UPDATES, " nsec/update");
+
+  // setText() w/o panel ID (search all panels)
+  t0 = gx::usecTime();
+  for (int i = 0; i < UPDATES; ++i) {
+    gui.setText(0, ((i * 2) % total) + 1, txt);
+  }
+  t1 = gx::usecTime();
+  println("setText(0):      ",
+          double(t1 - t0) * 1000.0 / UPDATES, " nsec/update");
+
+  // setBool()/getBool()
+  int count = 0;
+  t0 = gx::usecTime();
+  for (int i = 0; i < UPDATES; ++i) {
+    const int no = ((i * 2) % total) + 1; // checkbox elements
+    const gx::PanelID pid = (no / perPanel) + 1;
+    gui.setBool(pid, no + 1, (i & 2) != 0);
+    count += gui.getBool(pid, no + 1);
+  }
+  t1 = gx::usecTime();
+  println("setBool/getBool: ",
+          double(t1 - t0) * 1000.0 / UPDATES, " nsec/update  (", count, ")");
+  return 0;
+}
@@ -0,0 +1,292 @@
+//
+// bench_gui_update.cc
+// Copyright (C) 2026 Richard Bradley
+//
+// Gui::update() benchmark (headless, no window/renderer needed)
+// - builds large panels & replays scripted input event sequences
+//   (mouse sweeps, menu use, typing, scrolling, label updates)
+// - reports update/layout/drawList time per event, drawList size & text
+//   layout cache hit rate
+//
+
+#include "gx/Gui.hh"
+#include "gx/GuiBuilder.hh"
+#include "gx/GuiTheme.hh"
+#include "gx/EventState.hh"
+#include "gx/Font.hh"
+#include "gx/Time.hh"
+#include "gx/Print.hh"
+#include "gx/CmdLineParser.hh"
+#include <string>
+#include <vector>
+
+using gx::println;
+using gx::println_err;
+
+
+// **** Constants ****
+constexpr const char* FONT_FILE = "data/FreeSans.ttf";
+constexpr int WIDTH = 1920;
+constexpr int HEIGHT = 1080;
+constexpr int DEFAULT_REPEAT = 20;
+constexpr int TOOLBAR_ROWS = 40;
+constexpr int TOOLBAR_COLS = 25;
+constexpr int LIST_ROWS = 100000;
+constexpr int EDIT_LINES = 10000;
+constexpr int64_t EVENT_USEC = 100000;  // time between events
+
+enum {
+  ID_MENU = 1, ID_ENTRY, ID_EDIT, ID_LIST, ID_STATUS,
+  ID_BUTTON0 = 100
+};
+
+
+// **** Event script ****
+class EventScript
+{
+ public:
+  explicit EventScript(int64_t& time) : _time{time} { }
+
+  void move(gx::Vec2 pt) { add(gx::EVENT_MOUSE_MOVE, pt); }
+
+  void click(gx::Vec2 pt) {
+    add(gx::EVENT_MOUSE_MOVE | gx::EVENT_INPUT, pt).inputStates.push_back(
+      {gx::BUTTON_1, 0, 1, 0, true});
+    add(gx::EVENT_INPUT, pt).inputStates.push_back(
+      {gx::BUTTON_1, 0, 0, 0, false});
+  }
+
+  void key(gx::InputEnum key) {
+    add(gx::EVENT_INPUT, _pt).inputStates.push_back({key, 0, 1, 0, true});
+    add(gx::EVENT_INPUT, _pt).inputStates.push_back({key, 0, 0, 0, false});
+  }
+
+  void text(std::string_view txt) {
+    for (char ch : txt) {
+      if (ch == '\n') {
+        key(gx::KEY_ENTER);
+      } else {
+        add(gx::EVENT_TEXT, _pt).text.assign(1, ch);
+      }
+    }
+  }
+
+  void scroll(gx::Vec2 pt, float dy) {
+    add(gx::EVENT_MOUSE_MOVE | gx::EVENT_MOUSE_SCROLL, pt).scrollPt = {0, dy};
+  }
+
+  [[nodiscard]] const std::vector<gx::EventState>& events() const {
+    return _events; }
+
+ private:
+  std::vector<gx::EventState> _events;
+  gx::Vec2 _pt{};
+  int64_t& _time;
+
+  gx::EventState& add(int events, gx::Vec2 pt) {
+    _time += EVENT_USEC;
+    _pt = pt;
+    gx::EventState& es = _events.emplace_back();
+    es.lastPollTime = _time;
+    es.mousePt = pt;
+    es.scrollPt = {};
+    es.events = events;
+    es.mods = 0;
+    es.mouseIn = true;
+    es.iconified = false;
+    es.focused = true;
+    return es;
+  }
+};
+
+
+// **** Benchmark ****
+struct Result {
+  int events = 0;
+  int64_t updateNsec = 0;
+  std::size_t drawListSize = 0;
+};
+
+Result replay(gx::Gui& gui, const EventScript& script, int repeat,
+              int64_t& time)
+{
+  // event times are shifted to follow 'time' for each repeat
+  // (keeps time increasing for click-count/repeat/blink logic)
+  Result r;
+  const auto& events = script.events();
+  if (events.empty()) { return r; }
+  for (int i = 0; i < repeat; ++i) {
+    const int64_t offset = time + EVENT_USEC - events.front().lastPollTime;
+    for (const gx::EventState& e : events) {
+      gx::EventState es = e;
+      es.lastPollTime += offset;
+      time = es.lastPollTime;
+      const int64_t t0 = gx::nsecTime();
+      gui.update(es, e.events, WIDTH, HEIGHT);
+      r.updateNsec += gx::nsecTime() - t0;
+      r.drawListSize += gui.drawList().size();
+      ++r.events;
+    }
+  }
+  return r;
+}
+
+void report(const char* name, const gx::Gui& gui, const Result& r)
+{
+  const double n = double(r.events);
+  const gx::GuiStats& s = gui.stats();
+  println(name, double(r.updateNsec) / n / 1000.0, " usec/event  (layout ",
+          double(s.layoutNsec) / n / 1000.0, ", draw ",
+          double(s.renderNsec) / n / 1000.0, ", ", s.renders,
+          " redraws, drawList ", r.drawListSize / std::size_t(r.events), ")");
+  const gx::TextLayoutCache& tc = gui.textCache();
+  println("  text cache ", tc.hitRate() * 100.0, "% hits, ",
+          double(tc.maxSavedNsec()) / n / 1000.0,
+          " usec/event max layout saved");
+}
+
+gx::Vec2 elemPt(const gx::Gui& gui, gx::EventID eid, float fx, float fy)
+{
+  gx::Rect r{};
+  gui.getElemLayout(0, eid, r);
+  return {r.x + (r.w * fx), r.y + (r.h * fy)};
+}
+
+int main(int argc, char** argv)
+{
+  int repeat = DEFAULT_REPEAT;
+  for (gx::CmdLineParser p{argc, argv}; p; ++p) {
+    if (p.option() || !p.get(repeat) || repeat < 1) {
+      println_err("usage: ", argv[0], " [repeat]");
+      return -1;
+    }
+  }
+
+  gx::Font fnt{20};
+  if (!fnt.load(FONT_FILE)) {
+    println_err("ERROR: can't load font '", FONT_FILE, "'");
+    return -1;
+  }
+
+  gx::GuiTheme theme{&fnt};
+  gx::Gui gui;
+
+  // dense button grid
+  gx::GuiElem grid = gx::guiVFrame();
+  for (int row = 0; row < TOOLBAR_ROWS; ++row) {
+    gx::GuiElem line = gx::guiHFrame();
+    for (int col = 0; col < TOOLBAR_COLS; ++col) {
+      const gx::EventID eid = ID_BUTTON0 + (row * TOOLBAR_COLS) + col;
+      line.elems.push_back(gx::guiButton(eid, "Btn"));
+    }
+    grid.elems.push_back(std::move(line));
+  }
+  gui.newPanel(theme, 0, 40, gx::Align::top_left, 0, std::move(grid));
+
+  gui.newPanel(theme, 0, 0, gx::Align::top_left, 0,
+    gx::guiMenu(ID_MENU, "Menu", gx::guiMenuItem(1, "Item 1"),
+                gx::guiMenuItem(2, "Item 2"), gx::guiMenuItem(3, "Item 3"),
+                gx::guiMenuItem(4, "Item 4"), gx::guiMenuItem(5, "Item 5")));
+
+  gui.newPanel(theme, WIDTH - 400, 40, gx::Align::top_left, 0,
+    gx::guiHFrame(gx::guiLabel("Entry:"),
+                  gx::guiTextEntry(ID_ENTRY, 20, 200)));
+
+  std::string editText;
+  for (int i = 0; i < EDIT_LINES; ++i) {
+    editText += "line ";
+    editText += std::to_string(i);
+    editText += " of the text edit benchmark document\n";
+  }
+  gui.newPanel(theme, WIDTH - 400, 120, gx::Align::top_left, 0,
+               gx::guiTextEdit(ID_EDIT, 24, 20, editText));
+
+  gui.newPanel(theme, WIDTH - 400, 660, gx::Align::top_left, 0,
+    gx::guiList(ID_LIST, 24, 15, LIST_ROWS, [](int row, std::string& out) {
+      out = "row ";
+      out += std::to_string(row);
+    }));
+
+  const gx::PanelID status = gui.newPanel(
+    theme, 0, HEIGHT - 40, gx::Align::top_left, 0,
+    gx::guiLabel(ID_STATUS, "status"));
+
+  int64_t time = 0;
+  gx::EventState es0{};
+  es0.focused = true;
+  gui.update(es0, 0, WIDTH, HEIGHT);  // initial layout/drawList
+
+  // build event scripts
+  EventScript sweep{time};
+  for (int y = 40; y < 40 + (TOOLBAR_ROWS * 24); y += 7) {
+    for (int x = 0; x < TOOLBAR_COLS * 50; x += 13) {
+      sweep.move(gx::Vec2(float(x), float(y)));
+    }
+  }
+
+  EventScript menu{time};
+  const gx::Vec2 menuPt = elemPt(gui, ID_MENU, .5f, .5f);
+  const float itemH = (menuPt.y - elemPt(gui, ID_MENU, .5f, 0).y) * 2.0f;
+  for (int i = 0; i < 20; ++i) {
+    menu.click(menuPt);
+    for (int item = 1; item <= 5; ++item) {
+      menu.move(menuPt + gx::Vec2(0, float(item) * itemH));
+    }
+    menu.click(menuPt + gx::Vec2(0, float((i % 5) + 1) * itemH));
+  }
+
+  EventScript typeEntry{time};
+  typeEntry.click(elemPt(gui, ID_ENTRY, .8f, .5f));
+  for (int i = 0; i < 8; ++i) {
+    typeEntry.text("hello world ");
+    for (int j = 0; j < 12; ++j) { typeEntry.key(gx::KEY_BACKSPACE); }
+  }
+
+  EventScript typeEdit{time};
+  typeEdit.click(elemPt(gui, ID_EDIT, .5f, .5f));
+  for (int i = 0; i < 4; ++i) {
+    typeEdit.text("The quick brown fox jumps over the lazy dog.\n");
+    typeEdit.key(gx::KEY_PAGE_DOWN);
+  }
+
+  EventScript scroll{time};
+  const gx::Vec2 listPt = elemPt(gui, ID_LIST, .5f, .5f);
+  const gx::Vec2 editPt = elemPt(gui, ID_EDIT, .5f, .5f);
+  for (int i = 0; i < 200; ++i) {
+    const float dy = (i % 100) < 50 ? -3.0f : 3.0f;
+    scroll.scroll(listPt, dy);
+    scroll.scroll(editPt, dy);
+  }
+
+  println(TOOLBAR_ROWS * TOOLBAR_COLS, " buttons, ", LIST_ROWS,
+          " list rows, ", EDIT_LINES, " text edit lines, x", repeat);
+
+  gui.resetStats();
+  report("mouse sweep:     ", gui, replay(gui, sweep, repeat, time));
+  gui.resetStats();
+  report("menu:            ", gui, replay(gui, menu, repeat, time));
+  gui.resetStats();
+  report("entry typing:    ", gui, replay(gui, typeEntry, repeat, time));
+  gui.resetStats();
+  report("textedit typing: ", gui, replay(gui, typeEdit, repeat, time));
+  gui.resetStats();
+  report("scroll:          ", gui, replay(gui, scroll, repeat, time));
+
+  // label text updates (relayout of panel w/ each update)
+  gui.resetStats();
+  Result r;
+  const int updates = 1000 * repeat;
+  for (int i = 0; i < updates; ++i) {
+    gx::EventState es{};
+    es.lastPollTime = (time += EVENT_USEC);
+    es.focused = true;
+    gui.setText(status, ID_STATUS, std::to_string(i));
+    const int64_t t0 = gx::nsecTime();
+    gui.update(es, 0, WIDTH, HEIGHT);
+    r.updateNsec += gx::nsecTime() - t0;
+    r.drawListSize += gui.drawList().size();
+    ++r.events;
+  }
+  report("label setText:   ", gui, r);
+  return 0;
+}
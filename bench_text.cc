@@ -0,0 +1,149 @@
+//
+// bench_text.cc
+// Copyright (C) 2026 Richard Bradley
+//
+// Text layout benchmark (headless, no window/renderer needed)
+// - times TextFormat::calcProperties()/fitText() & DrawContext2D::text()
+//   for ASCII, Latin/Greek/Cyrillic, CJK & unknown glyph text
+// - times centered DrawContext2D::text() w/ & w/o a TextLayoutCache
+// - reports average time per character
+//
+
+#include "gx/DrawContext2D.hh"
+#include "gx/DrawList.hh"
+#include "gx/TextFormat.hh"
+#include "gx/TextLayoutCache.hh"
+#include "gx/Font.hh"
+#include "gx/Time.hh"
+#include "gx/Print.hh"
+#include "gx/CmdLineParser.hh"
+#include <string>
+#include <string_view>
+
+using gx::println;
+using gx::println_err;
+
+
+// **** Constants ****
+constexpr const char* FONT_FILE = "data/FreeSans.ttf";
+constexpr const char* CJK_FONT_FILE = "data/DroidSansJapanese.ttf";
+constexpr int FONT_SIZE = 20;
+constexpr int DEFAULT_REPEAT = 2000;
+constexpr int LINES = 40;
+
+constexpr const char* ASCII_LINE =
+  "The quick brown fox jumps over the lazy dog. 0123456789 (x+y)*z\n";
+constexpr const char* EUROPEAN_LINE =
+  "Größe Ärger café naïve façade — Αλφάβητο ελληνικά — "
+  "Кириллица русский текст\n";
+constexpr const char* CJK_LINE =
+  "日本語のテキストを表示するためのベンチマークです。漢字とかな\n";
+constexpr const char* UNKNOWN_LINE =
+  "unknown \U0001F600\U0001F680\U0001F4A1 glyphs ☃❤ "
+  "\U0001D49C\U0001D4AE text\n";
+
+
+// **** Benchmark ****
+std::string makeText(const char* line)
+{
+  std::string txt;
+  for (int i = 0; i < LINES; ++i) { txt += line; }
+  return txt;
+}
+
+int charCount(std::string_view s)
+{
+  // UTF-8 characters (non-continuation bytes)
+  int n = 0;
+  for (char ch : s) { n += ((uint8_t(ch) & 0xc0) != 0x80) ? 1 : 0; }
+  return n;
+}
+
+void bench(const char* name, const gx::TextFormat& tf, const char* line,
+           int repeat)
+{
+  const std::string txt = makeText(line);
+  const double chars = double(charCount(txt)) * double(repeat);
+  float width = 0;
+  std::size_t fitLen = 0;
+
+  int64_t t0 = gx::nsecTime();
+  for (int i = 0; i < repeat; ++i) {
+    width += tf.calcProperties(txt).width;
+  }
+  const int64_t propNsec = gx::nsecTime() - t0;
+
+  t0 = gx::nsecTime();
+  for (int i = 0; i < repeat; ++i) {
+    fitLen += tf.fitText(line, float(100 + (i % 400))).size();
+  }
+  const int64_t fitNsec = gx::nsecTime() - t0;
+  const double fitChars = double(charCount(line)) * double(repeat);
+
+  gx::DrawList dl;
+  gx::DrawContext2D dc{dl};
+  t0 = gx::nsecTime();
+  for (int i = 0; i < repeat; ++i) {
+    dc.clearList();
+    dc.color(gx::WHITE);
+    dc.text(tf, {0, 0}, gx::Align::top_left, txt);
+  }
+  const int64_t textNsec = gx::nsecTime() - t0;
+
+  // centered text (per line width calc) w/ & w/o layout cache
+  int64_t centerNsec[2] = {};
+  gx::TextLayoutCache cache;
+  gx::TextLayoutCache* caches[] = {nullptr, &cache};
+  for (int c = 0; c < 2; ++c) {
+    dc.textCache(caches[c]);
+    t0 = gx::nsecTime();
+    for (int i = 0; i < repeat; ++i) {
+      dc.clearList();
+      dc.color(gx::WHITE);
+      dc.text(tf, {0, 0}, gx::Align::center, txt);
+    }
+    centerNsec[c] = gx::nsecTime() - t0;
+  }
+
+  println(name, double(propNsec) / chars, " nsec/char calcProperties, ",
+          double(fitNsec) / fitChars, " fitText, ",
+          double(textNsec) / chars, " text");
+  println("  centered text ", double(centerNsec[0]) / chars, " nsec/char, ",
+          double(centerNsec[1]) / chars, " cached (hit rate ",
+          cache.hitRate() * 100.0, "%, ",
+          double(cache.maxSavedNsec()) / 1000000.0,
+          " msec max layout saved)");
+  println("  (width ", width / float(repeat), ", avg fit ",
+          double(fitLen) / double(repeat), " bytes, ", dl.size(),
+          " values)");
+}
+
+int main(int argc, char** argv)
+{
+  int repeat = DEFAULT_REPEAT;
+  for (gx::CmdLineParser p{argc, argv}; p; ++p) {
+    if (p.option() || !p.get(repeat) || repeat < 1) {
+      println_err("usage: ", argv[0], " [repeat]");
+      return -1;
+    }
+  }
+
+  gx::Font fnt{FONT_SIZE}, cjkFnt{FONT_SIZE};
+  if (!fnt.load(FONT_FILE)) {
+    println_err("ERROR: can't load font '", FONT_FILE, "'");
+    return -1;
+  } else if (!cjkFnt.load(CJK_FONT_FILE)) {
+    println_err("ERROR: can't load font '", CJK_FONT_FILE, "'");
+    return -1;
+  }
+
+  const gx::TextFormat tf{&fnt};
+  const gx::TextFormat cjkTf{&cjkFnt};
+
+  println(LINES, " lines x ", repeat);
+  bench("ascii:    ", tf, ASCII_LINE, repeat);
+  bench("european: ", tf, EUROPEAN_LINE, repeat);
+  bench("cjk:      ", cjkTf, CJK_LINE, repeat);
+  bench("unknown:  ", tf, UNKNOWN_LINE, repeat);
+  return 0;
+}
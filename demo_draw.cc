@@ -14,6 +14,8 @@
 #include "gx/DrawContext2D.hh"
 #include "gx/Print.hh"
 #include "gx/StringUtil.hh"
+#include <vector>
+#include <cmath>
 
 using gx::println_err;
 using gx::Vec2;
@@ -185,6 +187,46 @@ void draw_rborder5(gx::DrawContext2D& dc, const gx::Rect& r)
                          48, 4, 32.0f, WHITE, gx::packRGBA8(1,1,1,0), RED);
 }
 
+void draw_sdf1(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  dc.sdfShapes(true);
+  dc.color(GRAY50);
+  dc.circle(r.centerPt(), 150, 0);
+  dc.sdfShapes(false);
+}
+
+void draw_sdf2(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  dc.sdfShapes(true);
+  dc.hgradient(r.x+50, BLACK, r.x+350, WHITE);
+  dc.circleSector(r.centerPt(), 150, 20, 270, 0);
+  dc.sdfShapes(false);
+}
+
+void draw_sdf3(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  dc.sdfShapes(true);
+  dc.vgradient(r.y+30, WHITE, r.y+330, BLACK);
+  dc.roundedRectangle({r.x+20, r.y+30, 360, 300}, 60, 0);
+  dc.sdfShapes(false);
+}
+
+void draw_sdf4(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  dc.sdfShapes(true);
+  dc.color(WHITE);
+  dc.arc({r.x + 200, r.y + 180}, 150, 20, 270, 0, 16);
+  dc.sdfShapes(false);
+}
+
+void draw_sdf5(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  dc.sdfShapes(true);
+  dc.color(GRAY50);
+  dc.roundedBorder({r.x + 20, r.y + 30, 360, 300}, 40, 0, 4.0f);
+  dc.sdfShapes(false);
+}
+
 void draw_lines1(gx::DrawContext2D& dc, const gx::Rect& r)
 {
   const float x = r.x + .5f;
@@ -213,6 +255,46 @@ void draw_lines2(gx::DrawContext2D& dc, const gx::Rect& r)
   dc.line(origin, gx::Vertex2C{x+20,y+329,WHITE});
 }
 
+void draw_lines3(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  using Join = gx::DrawContext2D::LineJoin;
+  using Cap = gx::DrawContext2D::LineCap;
+  const Join joins[] = {Join::miter, Join::bevel, Join::round};
+  const Cap caps[] = {Cap::butt, Cap::square, Cap::round};
+
+  dc.color(WHITE);
+  float y = r.y + 60;
+  for (int i = 0; i < 3; ++i) {
+    dc.quadLines(16, joins[i], caps[i]);
+    dc.line(Vec2{r.x+40, y+60}, Vec2{r.x+120, y},
+            Vec2{r.x+200, y+60}, Vec2{r.x+360, y+20});
+    y += 100;
+  }
+  dc.quadLines(0);
+}
+
+void draw_lines4(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  dc.vgradient(r.y+30, RED, r.y+330, WHITE);
+  dc.quadLines(12, gx::DrawContext2D::LineJoin::round);
+  dc.lineLoop(Vec2{r.x+200, r.y+40}, Vec2{r.x+360, r.y+180},
+              Vec2{r.x+200, r.y+320}, Vec2{r.x+40, r.y+180});
+  dc.quadLines(0);
+}
+
+void draw_polyline1(gx::DrawContext2D& dc, const gx::Rect& r)
+{
+  // 1 million point noisy sine wave
+  static std::vector<float> y(1000000);
+  const float cy = r.y + 180;
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    y[i] = cy + (std::sin(float(i) * .00003f) * 100.0f) + float(i % 37) - 18.0f;
+  }
+
+  dc.color(GREEN);
+  dc.polyline(r.x+20, 360.0f / float(y.size()), y);
+}
+
 void draw_text1(gx::DrawContext2D& dc, const gx::Rect& r)
 {
   gx::TextFormat tf{.font = &TheFont};
@@ -332,8 +414,16 @@ struct { const char* desc; void(*fn)(gx::DrawContext2D&,const gx::Rect&); }
   {"VGradient Rounded Border", draw_rborder3},
   {"Shaded Rounded Border", draw_rborder4},
   {"Shaded Rounded Border Filled", draw_rborder5},
+  {"SDF Circle", draw_sdf1},
+  {"SDF HGradient Partial Circle", draw_sdf2},
+  {"SDF VGradient Rounded Rect", draw_sdf3},
+  {"SDF Partial Arc", draw_sdf4},
+  {"SDF Rounded Border", draw_sdf5},
   {"Lines", draw_lines1},
   {"Colored Lines", draw_lines2},
+  {"Quad Lines Miter/Bevel/Round", draw_lines3},
+  {"Quad Line Loop", draw_lines4},
+  {"Polyline (1M points)", draw_polyline1},
   {"Scaled/Rotated Text", draw_text1},
   {"Text Alignment Top/Left", draw_text2},
   {"Text Alignment Center", draw_text3},
@@ -9,6 +9,8 @@
 #include "gx/GuiBuilder.hh"
 #include "gx/Gui.hh"
 #include "gx/Print.hh"
+#include "gx/Time.hh"
+#include <algorithm>
 
 using gx::print_err;
 using gx::println_err;
@@ -16,17 +18,15 @@ using gx::println_err;
 
 constexpr int DEFAULT_WIDTH = 1280;
 constexpr int DEFAULT_HEIGHT = 720;
-constexpr int FONT_SIZE = 24;
 
-// font data from VariableWidthFontData.cc
-extern unsigned char VariableWidthFontData[];
-extern unsigned long VariableWidthFontDataSize;
+// prerendered font (size 24) from VariableWidthFontData.cc
+extern const gx::FontStaticData VariableWidthFont24;
 
 
 int main(int argc, char* argv[])
 {
-  gx::Font fnt{FONT_SIZE};
-  if (!fnt.loadFromMemory(VariableWidthFontData, VariableWidthFontDataSize)) {
+  gx::Font fnt;
+  if (!fnt.loadFromData(VariableWidthFont24)) {
     println_err("failed to load font");
     return -1;
   }
@@ -128,6 +128,26 @@ int main(int argc, char* argv[])
           gx::guiListSelectItem(5, "item 5"),
           gx::guiListSelectItem(6, "item six")) )));
 
+  // virtual list demo
+  gui.newPanel(
+    theme, 900, 80, gx::Align::top_left, gx::PANEL_FLOATING,
+    gx::guiVFrame(
+      gx::guiMargin(gx::guiTitleBar("LIST (50000 rows)"), 0,0,0,8),
+      gx::guiList(
+        70, 12.0f, 12, 50000,
+        [](int row, std::string& txt) {
+          txt = "row "; txt += std::to_string(row + 1); })));
+
+  // text edit demo
+  gui.newPanel(
+    theme, 600, 300, gx::Align::top_left, gx::PANEL_FLOATING,
+    gx::guiVFrame(
+      gx::guiMargin(gx::guiTitleBar("TEXT EDIT"), 0,0,0,8),
+      gx::guiTextEdit(
+        80, 24.0f, 8,
+        "Multi-line text edit\n\nline 3\nline 4\nline 5\nline 6\n"
+        "line 7\nline 8\nline 9\nline 10")));
+
   // window setup
   gx::Window win;
   win.setTitle("GUI demo");
@@ -146,7 +166,10 @@ int main(int argc, char* argv[])
   // **** MAIN LOOP ****
   while (running) {
     // handle events
-    gx::Window::pollEvents();
+    // (sleep until next event or gui timed update when idle)
+    const int64_t deadline = gui.nextDeadline();
+    gx::Window::waitEvents((deadline < 0) ? -1
+                           : std::max(deadline - gx::usecTime(), int64_t{0}));
     gx::EventState es = win.eventState();
 
     if (es.closed()) { running = false; }
@@ -166,9 +189,11 @@ int main(int argc, char* argv[])
       print_err("GUI event:", gui.event().eid);
       switch (gui.event().type) {
         case gx::GUI_ENTRY:
+        case gx::GUI_TEXTEDIT:
           println_err("\ttext:\"", gui.eventText(), "\"");
           break;
         case gx::GUI_LISTSELECT:
+        case gx::GUI_LIST:
           println_err("\titem_no:", gui.event().item_no);
           break;
         case gx::GUI_MENU:
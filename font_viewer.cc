@@ -65,11 +65,11 @@ int main(int argc, char** argv)
       const auto [width,height] = win.dimensions();
       const float tx = es.mousePt.x / float(width);
       const float ty = es.mousePt.y / float(height);
-      for (auto& [c,g] : fnt.glyphs()) {
+      for (const gx::Glyph& g : fnt.glyphs()) {
         if (tx >= g.t0.x && tx <= g.t1.x && ty >= g.t0.y && ty <= g.t1.y) {
-          if (lastCode != c) {
-            println_err("code:",c," '",gx::toUTF8(c),"'");
-            lastCode = c;
+          if (lastCode != g.code) {
+            println_err("code:",g.code," '",gx::toUTF8(g.code),"'");
+            lastCode = g.code;
           }
           break;
         }
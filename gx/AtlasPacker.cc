@@ -0,0 +1,159 @@
+//
+// gx/AtlasPacker.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "AtlasPacker.hh"
+#include "Assert.hh"
+#include <algorithm>
+#include <cmath>
+using namespace gx;
+
+
+namespace {
+  [[nodiscard]] constexpr int roundUp16(int x) { return (x + 15) & ~15; }
+}
+
+void AtlasPacker::init(int width, int height, int padding)
+{
+  GX_ASSERT(width > 0 && height > 0 && padding >= 0);
+  _width = width;
+  _height = height;
+  _padding = padding;
+  _usedHeight = 0;
+  _usedArea = 0;
+
+  // skyline is in padded space (items are padded on the right/bottom,
+  // area is reduced by padding to leave a gap on the left/top edges)
+  _skyline.clear();
+  _skyline.push_back({0, 0, std::max(width - padding, 0)});
+}
+
+int AtlasPacker::fitY(std::size_t index, int w, int h) const
+{
+  const int x = _skyline[index].x;
+  if ((x + w) > (_width - _padding)) { return -1; }
+
+  int y = 0, left = w;
+  for (std::size_t i = index; left > 0; ++i) {
+    const Node& n = _skyline[i];
+    y = std::max(y, n.y);
+    if ((y + h) > (_height - _padding)) { return -1; }
+    left -= n.width;
+  }
+  return y;
+}
+
+void AtlasPacker::addNode(std::size_t index, int x, int y, int w, int h)
+{
+  _skyline.insert(_skyline.begin() + std::ptrdiff_t(index), {x, y + h, w});
+
+  // shrink/remove segments covered by new segment
+  const int right = x + w;
+  std::size_t i = index + 1;
+  while (i < _skyline.size()) {
+    Node& n = _skyline[i];
+    if (n.x >= right) { break; }
+    const int shrink = right - n.x;
+    if (shrink < n.width) { n.x += shrink; n.width -= shrink; break; }
+    _skyline.erase(_skyline.begin() + std::ptrdiff_t(i));
+  }
+
+  // merge neighbor segments of the same height
+  for (std::size_t j = 1; j < _skyline.size(); ) {
+    if (_skyline[j - 1].y == _skyline[j].y) {
+      _skyline[j - 1].width += _skyline[j].width;
+      _skyline.erase(_skyline.begin() + std::ptrdiff_t(j));
+    } else {
+      ++j;
+    }
+  }
+}
+
+bool AtlasPacker::insert(int width, int height, int& x, int& y)
+{
+  GX_ASSERT(width >= 0 && height >= 0);
+  if (width == 0 || height == 0) { x = 0; y = 0; return true; }
+
+  const int w = width + _padding, h = height + _padding;
+  std::size_t best = _skyline.size();
+  int bestTop = 0, bestWidth = 0, bestY = 0;
+  for (std::size_t i = 0; i < _skyline.size(); ++i) {
+    const int fy = fitY(i, w, h);
+    if (fy < 0) { continue; }
+
+    const int top = fy + h;
+    if (best == _skyline.size() || top < bestTop
+        || (top == bestTop && _skyline[i].width < bestWidth)) {
+      best = i;
+      bestTop = top;
+      bestWidth = _skyline[i].width;
+      bestY = fy;
+    }
+  }
+
+  if (best == _skyline.size()) { return false; }
+
+  const int bx = _skyline[best].x;
+  addNode(best, bx, bestY, w, h);
+  x = bx + _padding;
+  y = bestY + _padding;
+  _usedHeight = std::max(_usedHeight, bestTop + _padding);
+  _usedArea += int64_t(width) * int64_t(height);
+  return true;
+}
+
+bool AtlasPacker::pack(std::span<Item> items)
+{
+  // tallest items first (then widest) gives the flattest skyline
+  std::vector<std::size_t> order(items.size());
+  for (std::size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+  std::stable_sort(order.begin(), order.end(),
+                   [items](std::size_t a, std::size_t b) {
+                     const Item& ia = items[a];
+                     const Item& ib = items[b];
+                     return (ia.height != ib.height)
+                       ? (ia.height > ib.height) : (ia.width > ib.width);
+                   });
+
+  bool status = true;
+  for (std::size_t i : order) {
+    Item& item = items[i];
+    if (!insert(item.width, item.height, item.x, item.y)) {
+      item.x = item.y = -1;
+      status = false;
+    }
+  }
+  return status;
+}
+
+bool AtlasPacker::packAll(std::span<Item> items, int maxSize, int padding)
+{
+  GX_ASSERT(maxSize > 0);
+
+  // start w/ square big enough for all items & widen until packed area
+  // is no taller than it is wide
+  int64_t area = 0;
+  int maxW = 0;
+  for (const Item& item : items) {
+    area += int64_t(item.width + padding) * int64_t(item.height + padding);
+    maxW = std::max(maxW, item.width);
+  }
+
+  int width = std::max(roundUp16(int(std::sqrt(double(area)))),
+                       roundUp16(maxW + (padding * 2)));
+  width = std::clamp(width, 16, maxSize);
+  for (;;) {
+    init(width, maxSize, padding);
+    const bool status = pack(items);
+    const int height = std::max(roundUp16(_usedHeight), 16);
+    if (status && (height <= width || width >= maxSize)) {
+      _height = std::min(height, maxSize);
+      return true;
+    } else if (width >= maxSize) {
+      return false;
+    }
+
+    width = std::min(roundUp16(width + (width / 16)), maxSize);
+  }
+}
@@ -0,0 +1,71 @@
+//
+// gx/AtlasPacker.hh
+// Copyright (C) 2026 Richard Bradley
+//
+// Rectangle packer for texture atlases (font glyphs, sprite sheets)
+// - skyline bottom-left placement (lowest top edge, then narrowest gap)
+// - pack()/packAll() insert items in decreasing height order
+//
+
+#pragma once
+#include "Types.hh"
+#include <vector>
+#include <span>
+#include <cstdint>
+
+
+class gx::AtlasPacker
+{
+ public:
+  struct Item {
+    int width = 0, height = 0;  // item size
+    int x = -1, y = -1;         // packed position (-1 if not packed)
+
+    [[nodiscard]] bool packed() const { return x >= 0; }
+  };
+
+  AtlasPacker() = default;
+  AtlasPacker(int width, int height, int padding = 0) {
+    init(width, height, padding); }
+
+  void init(int width, int height, int padding = 0);
+    // reset packer to an empty area
+    // - padding is the min gap between items & between items/area edges
+
+  bool insert(int width, int height, int& x, int& y);
+    // add single item, returns false if item doesn't fit
+    // (zero size items are placed at 0,0 & use no space)
+
+  bool pack(std::span<Item> items);
+    // add items in decreasing height order, returns false if any item
+    // didn't fit (items that fit are still packed)
+
+  bool packAll(std::span<Item> items, int maxSize, int padding = 0);
+    // reset & pack items into a near square area that is as small as
+    // possible (size is a multiple of 16, limited to maxSize x maxSize)
+    // - width()/height() are set to the area size used
+
+  [[nodiscard]] int width() const { return _width; }
+  [[nodiscard]] int height() const { return _height; }
+  [[nodiscard]] int padding() const { return _padding; }
+  [[nodiscard]] int usedHeight() const { return _usedHeight; }
+    // bottom edge of lowest item (w/ padding)
+  [[nodiscard]] int64_t usedArea() const { return _usedArea; }
+    // total area of packed items (w/o padding)
+  [[nodiscard]] float efficiency() const {
+    return (_usedHeight > 0) ? float(double(_usedArea)
+      / (double(_width) * double(_usedHeight))) : 0.0f; }
+    // used fraction of area above usedHeight()
+
+ private:
+  struct Node { int x, y, width; };  // skyline segment
+
+  std::vector<Node> _skyline;
+  int _width = 0, _height = 0, _padding = 0;
+  int _usedHeight = 0;
+  int64_t _usedArea = 0;
+
+  [[nodiscard]] int fitY(std::size_t index, int w, int h) const;
+    // top edge of item placed at skyline segment (-1 if it doesn't fit)
+  void addNode(std::size_t index, int x, int y, int w, int h);
+};
@@ -41,6 +41,8 @@ namespace gx {
     CMD_lineTo2,      // <cmd x y> (3)
     CMD_lineStart2C,  // <cmd x y c> (4)
     CMD_lineTo2C,     // <cmd x y c> (4)
+    CMD_polyline2,    // <cmd n (x y)*n> (2+n*2)
+    CMD_polyline2C,   // <cmd n (x y c)*n> (2+n*3)
     CMD_triangle2,    // <cmd (x y)x3> (7)
     CMD_triangle2T,   // <cmd (x y s t)x3> (13)
     CMD_triangle2C,   // <cmd (x y c)x3> (10)
@@ -52,6 +54,12 @@ namespace gx {
     CMD_rectangle,    // <cmd (x y)x2> (5)
     CMD_rectangleT,   // <cmd (x y s t)x2> (9)
 
+    // 2D SDF shapes (rounded box w/ optional border, evaluated per pixel)
+    CMD_shapeRectangle,  // <cmd (x y)x2 r bw> (7)
+    CMD_shapeRectangleC, // <cmd (x y)x2 r bw c*4> (11)
+    CMD_shapeTriangle2,  // <cmd cx cy r bw (x y)x3> (11)
+    CMD_shapeTriangle2C, // <cmd cx cy r bw (x y c)x3> (14)
+
     // 3D drawing
     CMD_line3,        // <cmd (x y z)x2> (7)
     CMD_line3C,       // <cmd (x y z c)x2> (9)
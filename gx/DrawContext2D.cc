@@ -4,13 +4,19 @@
 //
 
 #include "DrawContext2D.hh"
+#include "ShapeCache.hh"
+#include "TextLayoutCache.hh"
 #include "Font.hh"
+#include "Path.hh"
 #include "TextFormat.hh"
 #include "TextMetaState.hh"
 #include "Unicode.hh"
 #include "MathUtil.hh"
 #include "StringUtil.hh"
 #include "Assert.hh"
+#include <algorithm>
+#include <array>
+#include <utility>
 using namespace gx;
 
 
@@ -61,6 +67,128 @@ namespace {
     while (endAngle <= startAngle) { endAngle += 360.0f; }
     endAngle = std::min(endAngle, startAngle + 360.0f);
   }
+
+  // unit circle point tables for a 90 degree arc, (sin(a), -cos(a)) for
+  // 0-90 degrees, precomputed for segment counts 1-QUARTER_MAX
+  // (tables for a count are stored consecutively, count+1 points each)
+  constexpr int QUARTER_MAX = 32;
+
+  [[nodiscard]] constexpr int quarterOffset(int segments) {
+    return ((segments - 1) * (segments + 2)) / 2;
+  }
+
+  [[nodiscard]] constexpr double constSin(double x) {
+    // Taylor series (accurate for 0 <= x <= pi/2)
+    double term = x, sum = x;
+    for (int i = 1; i < 12; ++i) {
+      term *= -(x * x) / double((2*i) * ((2*i) + 1));
+      sum += term;
+    }
+    return sum;
+  }
+
+  [[nodiscard]] constexpr auto makeQuarterTables()
+  {
+    std::array<Vec2,quarterOffset(QUARTER_MAX+1)> t{};
+    for (int s = 1; s <= QUARTER_MAX; ++s) {
+      Vec2* pts = t.data() + quarterOffset(s);
+      for (int i = 0; i <= s; ++i) {
+        const double a = (PI<double> * .5 * i) / s;
+        const double b = (PI<double> * .5) - a;
+        pts[i] = {float(constSin(a)), float(-constSin(b))};
+      }
+    }
+    return t;
+  }
+
+  constexpr auto QUARTER_TABLES = makeQuarterTables();
+
+  void scaleArc(const Vec2* unit, Vec2* out, std::size_t n,
+                Vec2 center, float radius)
+  {
+    // separate scale/offset pass so the loop can be vectorized
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i].x = center.x + (unit[i].x * radius);
+      out[i].y = center.y + (unit[i].y * radius);
+    }
+  }
+
+  template<class GetY>
+  void minMaxY(std::size_t i0, std::size_t i1, const GetY& getY,
+               float& minVal, float& maxVal)
+  {
+    // independent accumulators so the loop can be vectorized
+    float mn[4], mx[4];
+    for (int k = 0; k < 4; ++k) { mn[k] = mx[k] = getY(i0); }
+
+    std::size_t i = i0;
+    for (; (i + 4) <= i1; i += 4) {
+      for (std::size_t k = 0; k < 4; ++k) {
+        const float v = getY(i + k);
+        mn[k] = std::min(mn[k], v);
+        mx[k] = std::max(mx[k], v);
+      }
+    }
+    for (; i < i1; ++i) {
+      const float v = getY(i);
+      mn[0] = std::min(mn[0], v);
+      mx[0] = std::max(mx[0], v);
+    }
+
+    minVal = min4(mn[0], mn[1], mn[2], mn[3]);
+    maxVal = max4(mx[0], mx[1], mx[2], mx[3]);
+  }
+
+  template<class GetX, class GetY>
+  void decimatePolyline(std::size_t n, const GetX& getX, const GetY& getY,
+                        float xStep, std::vector<Vec2>& out)
+  {
+    // consecutive points in the same pixel column are reduced to the
+    // first, min, max & last points of the column (M4 aggregation)
+    // xStep - fixed x spacing of points if known (0 otherwise)
+    out.clear();
+    std::size_t i = 0;
+    while (i < n) {
+      const float x0 = getX(i);
+      const float col = std::floor(x0);
+
+      // find end of column
+      std::size_t j = i + 1;
+      if (xStep > 0) {
+        // (step count clamped before conversion to avoid overflow)
+        const float steps = std::ceil((col + 1.0f - x0) / xStep);
+        j = i + std::max(std::size_t(std::min(float(n - i), steps)),
+                         std::size_t{1});
+        while (j > (i + 1) && std::floor(getX(j - 1)) != col) { --j; }
+      }
+      while (j < n && std::floor(getX(j)) == col) { ++j; }
+
+      const std::size_t last = j - 1;
+      if ((j - i) <= 4) {
+        for (std::size_t k = i; k < j; ++k) {
+          out.push_back({getX(k), getY(k)});
+        }
+      } else {
+        float minVal, maxVal;
+        minMaxY(i, j, getY, minVal, maxVal);
+        std::size_t iMin = i, iMax = i;
+        while (iMin < last && getY(iMin) != minVal) { ++iMin; }
+        while (iMax < last && getY(iMax) != maxVal) { ++iMax; }
+
+        const std::size_t a = std::min(iMin, iMax);
+        const std::size_t b = std::max(iMin, iMax);
+        out.push_back({getX(i), getY(i)});
+        if (a != i && a != last) {
+          out.push_back({getX(a), getY(a)});
+        }
+        if (b != a && b != i && b != last) {
+          out.push_back({getX(b), getY(b)});
+        }
+        out.push_back({getX(last), getY(last)});
+      }
+      i = j;
+    }
+  }
 }
 
 
@@ -127,7 +255,11 @@ void DrawContext2D::changeAlpha(float a)
 void DrawContext2D::line(Vec2 a, Vec2 b)
 {
   if ((_color0 | _color1) == 0) { return; }
-  if (_colorMode == ColorMode::solid) {
+  if (_qlWidth > 0) {
+    _quadLineStart({a.x, a.y, pointColor(a)});
+    _quadLineTo({b.x, b.y, pointColor(b)});
+    lineEnd();
+  } else if (_colorMode == ColorMode::solid) {
     setColor();
     _dl->line2(a, b);
   } else {
@@ -136,10 +268,23 @@ void DrawContext2D::line(Vec2 a, Vec2 b)
   }
 }
 
+void DrawContext2D::line(const Vertex2C& a, const Vertex2C& b)
+{
+  if (_qlWidth > 0) {
+    _quadLineStart(a);
+    _quadLineTo(b);
+    lineEnd();
+  } else {
+    _dl->line2C(a, b);
+  }
+}
+
 void DrawContext2D::lineStart(Vec2 a)
 {
   if ((_color0 | _color1) == 0) { return; }
-  if (_colorMode == ColorMode::solid) {
+  if (_qlWidth > 0) {
+    _quadLineStart({a.x, a.y, pointColor(a)});
+  } else if (_colorMode == ColorMode::solid) {
     setColor();
     _dl->lineStart2(a);
   } else {
@@ -147,10 +292,21 @@ void DrawContext2D::lineStart(Vec2 a)
   }
 }
 
+void DrawContext2D::lineStart(const Vertex2C& a)
+{
+  if (_qlWidth > 0) {
+    _quadLineStart(a);
+  } else {
+    _dl->lineStart2C(a);
+  }
+}
+
 void DrawContext2D::lineTo(Vec2 a)
 {
   if ((_color0 | _color1) == 0) { return; }
-  if (_colorMode == ColorMode::solid) {
+  if (_qlWidth > 0) {
+    _quadLineTo({a.x, a.y, pointColor(a)});
+  } else if (_colorMode == ColorMode::solid) {
     setColor();
     _dl->lineTo2(a);
   } else {
@@ -158,6 +314,243 @@ void DrawContext2D::lineTo(Vec2 a)
   }
 }
 
+void DrawContext2D::lineTo(const Vertex2C& a)
+{
+  if (_qlWidth > 0) {
+    _quadLineTo(a);
+  } else {
+    _dl->lineTo2C(a);
+  }
+}
+
+void DrawContext2D::polyline(std::span<const Vec2> pts)
+{
+  if (pts.size() < 2 || (_color0 | _color1) == 0) { return; }
+
+  decimatePolyline(pts.size(),
+                   [pts](std::size_t i){ return pts[i].x; },
+                   [pts](std::size_t i){ return pts[i].y; },
+                   0.0f, _polyPts);
+  _polyline(_polyPts);
+}
+
+void DrawContext2D::polyline(
+  float x0, float xStep, std::span<const float> y)
+{
+  if (y.size() < 2 || (_color0 | _color1) == 0) { return; }
+
+  decimatePolyline(y.size(),
+                   [x0,xStep](std::size_t i){ return x0 + (float(i) * xStep); },
+                   [y](std::size_t i){ return y[i]; },
+                   xStep, _polyPts);
+  _polyline(_polyPts);
+}
+
+void DrawContext2D::_polyline(std::span<const Vec2> pts)
+{
+  if (_qlWidth > 0) {
+    _quadLineStart({pts[0].x, pts[0].y, pointColor(pts[0])});
+    for (std::size_t i = 1; i < pts.size(); ++i) {
+      _quadLineTo({pts[i].x, pts[i].y, pointColor(pts[i])});
+    }
+    lineEnd();
+  } else if (_colorMode == ColorMode::solid) {
+    setColor();
+    _dl->polyline2(pts);
+  } else {
+    _colorPts.clear();
+    for (const Vec2& p : pts) {
+      _colorPts.push_back({p.x, p.y, pointColor(p)});
+    }
+    _dl->polyline2C(_colorPts);
+  }
+}
+
+void DrawContext2D::_quadLineStart(const Vertex2C& a)
+{
+  lineEnd();
+  _qlStart = _qlLast = a;
+  _qlState = 1;
+}
+
+void DrawContext2D::_quadLineTo(const Vertex2C& a)
+{
+  if (_qlState == 0) { _quadLineStart(a); return; }
+
+  const Vec2 p0{_qlLast.x, _qlLast.y};
+  const Vec2 p1{a.x, a.y};
+  const float len = pointDistance(p0, p1);
+  if (isZero(len)) { return; }
+
+  const Vec2 dir = (p1 - p0) * (1.0f / len);
+  if (_qlState == 2) {
+    _quadLineJoin(_qlLast, _qlLastDir, dir);
+  } else {
+    _qlStartDir = dir;
+  }
+
+  // segment body
+  const float hw = _qlWidth * .5f;
+  const Vec2 n{-dir.y * hw, dir.x * hw};
+  _qlQuad({p0.x + n.x, p0.y + n.y, _qlLast.c},
+          {p1.x + n.x, p1.y + n.y, a.c},
+          {p0.x - n.x, p0.y - n.y, _qlLast.c},
+          {p1.x - n.x, p1.y - n.y, a.c});
+
+  _qlLast = a;
+  _qlLastDir = dir;
+  _qlState = 2;
+}
+
+void DrawContext2D::_quadLineEnd()
+{
+  _quadLineCap(_qlStart, -_qlStartDir);
+  _quadLineCap(_qlLast, _qlLastDir);
+  _qlState = 0;
+}
+
+void DrawContext2D::_quadLineClose()
+{
+  if (_qlState == 2 && isEq(_qlLast.x, _qlStart.x)
+      && isEq(_qlLast.y, _qlStart.y)) {
+    // closed loop - join last segment to first instead of adding caps
+    _quadLineJoin(_qlLast, _qlLastDir, _qlStartDir);
+    _qlState = 0;
+  } else {
+    lineEnd();
+  }
+}
+
+void DrawContext2D::_quadLineJoin(const Vertex2C& pt, Vec2 dir0, Vec2 dir1)
+{
+  const float cross = (dir0.x * dir1.y) - (dir0.y * dir1.x);
+  const float dot = dotProduct(dir0, dir1);
+  if (isZero(cross) && dot > 0) { return; } // no direction change
+
+  // join is on the outer side of the turn
+  const float hw = _qlWidth * .5f;
+  const float side = (cross > 0) ? -hw : hw;
+  const Vec2 n0{-dir0.y * side, dir0.x * side};
+  const Vec2 n1{-dir1.y * side, dir1.x * side};
+  const Vertex2C p0{pt.x + n0.x, pt.y + n0.y, pt.c};
+  const Vertex2C p1{pt.x + n1.x, pt.y + n1.y, pt.c};
+
+  switch (_qlJoin) {
+    case LineJoin::round: {
+      const float angle = std::acos(std::clamp(dot, -1.0f, 1.0f));
+      _quadLineFan(pt, n0, (cross > 0) ? angle : -angle);
+      break;
+    }
+    case LineJoin::miter: {
+      // miter limit of 4 (SVG default), bevel used past limit
+      const float cosHalf = std::sqrt((1.0f + dot) * .5f);
+      if (cosHalf > .25f) {
+        const Vec2 m = unitVec(n0 + n1) * (std::abs(side) / cosHalf);
+        _qlQuad(p0, {pt.x + m.x, pt.y + m.y, pt.c}, pt, p1);
+        break;
+      }
+      [[fallthrough]];
+    }
+    default: // LineJoin::bevel
+      if (!isZero(cross)) { _qlTriangle(pt, p0, p1); }
+      break;
+  }
+}
+
+void DrawContext2D::_quadLineCap(const Vertex2C& pt, Vec2 dir)
+{
+  const float hw = _qlWidth * .5f;
+  const Vec2 n{-dir.y * hw, dir.x * hw};
+  switch (_qlCap) {
+    case LineCap::square: {
+      const Vec2 e{dir.x * hw, dir.y * hw};
+      _qlQuad({pt.x + n.x, pt.y + n.y, pt.c},
+              {pt.x + n.x + e.x, pt.y + n.y + e.y, pt.c},
+              {pt.x - n.x, pt.y - n.y, pt.c},
+              {pt.x - n.x + e.x, pt.y - n.y + e.y, pt.c});
+      break;
+    }
+    case LineCap::round:
+      _quadLineFan(pt, n, -PI<float>);
+      break;
+    default: // LineCap::butt
+      break;
+  }
+}
+
+void DrawContext2D::_quadLineFan(const Vertex2C& pt, Vec2 offset, float angle)
+{
+  // triangle fan around pt starting at pt+offset, segment count based on
+  // 1/4 pixel max error from the true curve
+  const float hw = _qlWidth * .5f;
+  const float maxStep =
+    (hw > .25f) ? 2.0f * std::acos(1.0f - (.25f / hw)) : PI<float>;
+  const int segments = std::max(int(std::ceil(std::abs(angle) / maxStep)), 1);
+  const float step = angle / float(segments);
+  const float sa = std::sin(step), ca = std::cos(step);
+
+  Vec2 v = offset;
+  for (int i = 0; i < segments; ++i) {
+    const Vec2 v2{(v.x * ca) - (v.y * sa), (v.x * sa) + (v.y * ca)};
+    _qlTriangle(pt, {pt.x + v.x, pt.y + v.y, pt.c},
+                {pt.x + v2.x, pt.y + v2.y, pt.c});
+    v = v2;
+  }
+}
+
+void DrawContext2D::_qlTriangle(
+  const Vertex2C& a, const Vertex2C& b, const Vertex2C& c)
+{
+  if (a.c == b.c && a.c == c.c) {
+    if (_dataColor != a.c) { _dataColor = a.c; _dl->color(a.c); }
+    _dl->triangle2({a.x, a.y}, {b.x, b.y}, {c.x, c.y});
+  } else {
+    _dl->triangle2C(a, b, c);
+  }
+}
+
+void DrawContext2D::_qlQuad(const Vertex2C& a, const Vertex2C& b,
+                            const Vertex2C& c, const Vertex2C& d)
+{
+  if (a.c == b.c && a.c == c.c && a.c == d.c) {
+    if (_dataColor != a.c) { _dataColor = a.c; _dl->color(a.c); }
+    _dl->quad2({a.x, a.y}, {b.x, b.y}, {c.x, c.y}, {d.x, d.y});
+  } else {
+    _dl->quad2C(a, b, c, d);
+  }
+}
+
+void DrawContext2D::fillPath(const Path& p)
+{
+  if (!checkColor()) { return; }
+
+  const auto& tri = p.triangles();
+  for (std::size_t i = 0; (i + 2) < tri.size(); i += 3) {
+    const Vec2 a = tri[i], b = tri[i+1], c = tri[i+2];
+    if (_colorMode == ColorMode::solid) {
+      _dl->triangle2(a, b, c);
+    } else {
+      _dl->triangle2C({a.x, a.y, pointColor(a)},
+                      {b.x, b.y, pointColor(b)},
+                      {c.x, c.y, pointColor(c)});
+    }
+  }
+}
+
+void DrawContext2D::strokePath(const Path& p)
+{
+  for (const Path::Contour& c : p.contours()) {
+    lineStart(c.points[0]);
+    for (std::size_t i = 1; i < c.points.size(); ++i) { lineTo(c.points[i]); }
+    if (c.closed) {
+      lineTo(c.points[0]);
+      _quadLineClose();
+    } else {
+      lineEnd();
+    }
+  }
+}
+
 void DrawContext2D::triangle(Vec2 a, Vec2 b, Vec2 c)
 {
   if ((_color0 | _color1) == 0) { return; }
@@ -335,13 +728,10 @@ void DrawContext2D::glyph(
 
   GX_ASSERT(tf.font != nullptr);
   const Font& f = *tf.font;
-  const Glyph* g = f.findGlyph(code);
-  if (!g) {
-    g = f.findGlyph(f.unknownCode());
-    GX_ASSERT(g != nullptr);
-  }
+  const Glyph* g = f.findGlyphOrUnknown(code);
+  GX_ASSERT(g != nullptr);
 
-  if (!g->bitmap) { return; }
+  if (g->empty()) { return; }
 
   const Align v_align = vAlign(align);
   if (v_align == Align::top) {
@@ -358,7 +748,6 @@ void DrawContext2D::glyph(
     pos -= tf.advX * ((h_align == Align::right) ? tw : (tw * .5f));
   }
 
-  texture(f.atlas());
   _glyph(*g, tf, pos);
 }
 
@@ -381,9 +770,42 @@ void DrawContext2D::text(
     pos += tf.advY * ((f.ymax() - (lh * float(lineCount(text) - 1))) * .5f);
   } // otherwise, pos is baseline of 1st line
 
-  texture(f.atlas());
   if (_colorMode == ColorMode::solid) { setColor(); }
 
+  if (_textCache) {
+    // draw from cached layout unless selected ID highlighting applies
+    // (uncommon, handled by uncached draw)
+    const TextLayoutCache::Entry& e = _textCache->get(tf, text);
+    const bool selected = (_selectedID != 0)
+      && (_selectedColor != 0 || _selectedUL)
+      && std::any_of(e.regions.begin(), e.regions.end(),
+                     [id=_selectedID](const auto& r){ return r.id == id; });
+    if (!selected) {
+      const RGBA8 initColor = _color0;
+      for (const TextLayoutCache::Item& i : e.items) {
+        switch (i.type) {
+          case TextLayoutCache::ITEM_glyph:
+          case TextLayoutCache::ITEM_underline: {
+            const float w = e.lineWidths[i.line];
+            const float offset = (h_align == Align::left) ? 0.0f
+              : ((h_align == Align::right) ? w : (w * .5f));
+            const Vec2 p = pos + (tf.advY * (lh * float(i.line)))
+              + (tf.advX * (i.x - offset));
+            _glyph(*i.glyph, tf, p, i.width);
+            break;
+          }
+          case TextLayoutCache::ITEM_color:
+            color(i.color); break;
+          case TextLayoutCache::ITEM_initColor:
+            color(initColor); break;
+          case TextLayoutCache::ITEM_setColor:
+            setColor(); break;
+        }
+      }
+      return;
+    }
+  }
+
   TextMetaState ts;
   RGBA8 initColor = _color0; // TODO: track initial gradients
 
@@ -472,14 +894,11 @@ void DrawContext2D::text(
         }
       }
 
-      const Glyph* g = f.findGlyph(ch);
-      if (!g) {
-        g = f.findGlyph(f.unknownCode());
-        GX_ASSERT(g != nullptr);
-      }
+      const Glyph* g = f.findGlyphOrUnknown(ch);
+      GX_ASSERT(g != nullptr);
 
       const Vec2 p = pos + (tf.advX * (len - offset));
-      if (g->bitmap) { _glyph(*g, tf, p); }
+      if (!g->empty()) { _glyph(*g, tf, p); }
       len += g->advX + tf.glyphSpacing;
 
       if (ulOp == UL_start) {
@@ -506,9 +925,10 @@ void DrawContext2D::text(
 void DrawContext2D::_glyph(
   const Glyph& g, const TextFormat& tf, Vec2 baseline, float altWidth)
 {
-  const Vec2 gx =
-    tf.glyphX * (altWidth > 0 ? altWidth : float(g.bitmap.width()));
-  const Vec2 gy = tf.glyphY * float(g.bitmap.height());
+  texture(g.tex);
+  const Vec2 gx = tf.glyphX * ((altWidth > 0)
+    ? altWidth + (tf.font->glyphPadding() * 2.0f) : float(g.width));
+  const Vec2 gy = tf.glyphY * float(g.height);
 
   // quad: A-B
   //       |/|
@@ -620,28 +1040,88 @@ void DrawContext2D::circleSector(
   if (!checkColor()) { return; }
 
   fixAngles(startAngle, endAngle);
-  _circleSector(
-    center, radius, degToRad(startAngle), degToRad(endAngle), segments);
+  if (_sdfShapes) {
+    _shapeSector(center, radius, degToRad(startAngle), degToRad(endAngle), 0);
+  } else {
+    _circleSector(
+      center, radius, degToRad(startAngle), degToRad(endAngle), segments);
+  }
+}
+
+void DrawContext2D::_unitArc(float angle0, float angle1, int segments)
+{
+  // fill _arcPts with segments+1 unit circle points, (sin(a), -cos(a)),
+  // followed by space for 2 scaled copies
+  if (segments < 1) { _arcPts.clear(); return; }
+
+  const std::size_t n = std::size_t(segments + 1);
+  _arcPts.resize(n * 3);
+  Vec2* pts = _arcPts.data();
+
+  // use precomputed tables for arcs made of whole quadrants
+  // (rounded rectangle corners, full circles)
+  constexpr float a90 = degToRad(90.0f);
+  const float q0 = std::round(angle0 / a90);
+  const float q1 = std::round(angle1 / a90);
+  const int quads = int(q1 - q0);
+  if (quads > 0 && (segments % quads) == 0
+      && (segments / quads) <= QUARTER_MAX
+      && std::abs((angle0 / a90) - q0) < .0001f
+      && std::abs((angle1 / a90) - q1) < .0001f) {
+    const int qs = segments / quads;
+    const Vec2* table = QUARTER_TABLES.data() + quarterOffset(qs);
+    int rot = int(q0) % 4;
+    if (rot < 0) { rot += 4; }
+
+    for (int q = 0; q < quads; ++q) {
+      // rotate table by 0/90/180/270 degrees for each quadrant
+      Vec2* out = pts + (q * qs);
+      const Vec2* t = table;
+      switch ((rot + q) % 4) {
+        default:
+          for (int i = 0; i <= qs; ++i) { out[i] = t[i]; }
+          break;
+        case 1:
+          for (int i = 0; i <= qs; ++i) { out[i] = {-t[i].y, t[i].x}; }
+          break;
+        case 2:
+          for (int i = 0; i <= qs; ++i) { out[i] = {-t[i].x, -t[i].y}; }
+          break;
+        case 3:
+          for (int i = 0; i <= qs; ++i) { out[i] = {t[i].y, -t[i].x}; }
+          break;
+      }
+    }
+    return;
+  }
+
+  const float segmentAngle = (angle1 - angle0) / float(segments);
+  for (int i = 0; i < segments; ++i) {
+    const float a = angle0 + (segmentAngle * float(i));
+    pts[i] = {std::sin(a), -std::cos(a)};
+  }
+  pts[segments] = {std::sin(angle1), -std::cos(angle1)};
+}
+
+const Vec2* DrawContext2D::_arcPoints(int slot, Vec2 center, float radius)
+{
+  // scale/offset unit points from last _unitArc() call into slot 1 or 2
+  const std::size_t n = _arcPts.size() / 3;
+  Vec2* out = _arcPts.data() + (n * std::size_t(slot));
+  scaleArc(_arcPts.data(), out, n, center, radius);
+  return out;
 }
 
 void DrawContext2D::_circleSector(
   Vec2 center, float radius, float angle0, float angle1, int segments)
 {
-  const float segmentAngle = (angle1 - angle0) / float(segments);
+  if (segments < 1) { return; }
+  _unitArc(angle0, angle1, segments);
+  const Vec2* pts = _arcPoints(1, center, radius);
   const Vec2 v0{center.x, center.y};
 
-  Vec2 v1{
-    center.x + (radius * std::sin(angle0)),
-    center.y - (radius * std::cos(angle0))};
-
-  float a = angle0;
   for (int i = 0; i < segments; ++i) {
-    if (i == segments-1) { a = angle1; } else { a += segmentAngle; }
-
-    const Vec2 v2{
-      center.x + (radius * std::sin(a)),
-      center.y - (radius * std::cos(a))};
-
+    const Vec2 v1 = pts[i], v2 = pts[i+1];
     if (_colorMode == ColorMode::solid) {
       _dl->triangle2(v0, v1, v2);
     } else {
@@ -649,9 +1129,6 @@ void DrawContext2D::_circleSector(
                       {v1.x, v1.y, pointColor(v1)},
                       {v2.x, v2.y, pointColor(v2)});
     }
-
-    // setup for next iteration
-    v1 = v2;
   }
 }
 
@@ -659,35 +1136,16 @@ void DrawContext2D::circleSectorShaded(
   Vec2 center, float radius, float startAngle, float endAngle, int segments,
   RGBA8 innerColor, RGBA8 outerColor)
 {
-  if ((innerColor | outerColor) == 0) { return; }
+  if ((innerColor | outerColor) == 0 || segments < 1) { return; }
 
   fixAngles(startAngle, endAngle);
-  const float angle0 = degToRad(startAngle);
-  const float angle1 = degToRad(endAngle);
-  const float segmentAngle = (angle1 - angle0) / float(segments);
-
+  _unitArc(degToRad(startAngle), degToRad(endAngle), segments);
+  const Vec2* pts = _arcPoints(1, center, radius);
   const Vertex2C v0{center.x, center.y, innerColor};
 
-  Vertex2C v1{
-    center.x + (radius * std::sin(angle0)),
-    center.y - (radius * std::cos(angle0)),
-    outerColor};
-
-  Vertex2C v2;
-  v2.c = outerColor;
-
-  float a = angle0;
   for (int i = 0; i < segments; ++i) {
-    if (i == segments-1) { a = angle1; } else { a += segmentAngle; }
-
-    v2.x = center.x + (radius * std::sin(a));
-    v2.y = center.y - (radius * std::cos(a));
-
-    triangle(v0, v1, v2);
-
-    // setup for next iteration
-    v1.x = v2.x;
-    v1.y = v2.y;
+    triangle(v0, {pts[i].x, pts[i].y, outerColor},
+             {pts[i+1].x, pts[i+1].y, outerColor});
   }
 }
 
@@ -698,29 +1156,27 @@ void DrawContext2D::arc(
   if (!checkColor()) { return; }
 
   fixAngles(startAngle, endAngle);
-  _arc(center, radius, degToRad(startAngle), degToRad(endAngle),
-       segments, arcWidth);
+  if (_sdfShapes) {
+    _shapeSector(center, radius, degToRad(startAngle), degToRad(endAngle),
+                 std::max(arcWidth, 0.0625f));
+  } else {
+    _arc(center, radius, degToRad(startAngle), degToRad(endAngle),
+         segments, arcWidth);
+  }
 }
 
 void DrawContext2D::_arc(
   Vec2 center, float radius, float angle0, float angle1,
   int segments, float arcWidth)
 {
-  const float segmentAngle = (angle1 - angle0) / float(segments);
-  const float innerR = radius - arcWidth;
-
-  const float sa0 = std::sin(angle0), ca0 = std::cos(angle0);
-  Vec2 v0{center.x + (radius * sa0), center.y - (radius * ca0)};
-  Vec2 v1{center.x + (innerR * sa0), center.y - (innerR * ca0)};
+  if (segments < 1) { return; }
+  _unitArc(angle0, angle1, segments);
+  const Vec2* outer = _arcPoints(1, center, radius);
+  const Vec2* inner = _arcPoints(2, center, radius - arcWidth);
 
-  float a = angle0;
   for (int i = 0; i < segments; ++i) {
-    if (i == segments-1) { a = angle1; } else { a += segmentAngle; }
-
-    const float sa = std::sin(a), ca = std::cos(a);
-    const Vec2 v2{center.x + (radius * sa), center.y - (radius * ca)};
-    const Vec2 v3{center.x + (innerR * sa), center.y - (innerR * ca)};
-
+    const Vec2 v0 = outer[i], v1 = inner[i];
+    const Vec2 v2 = outer[i+1], v3 = inner[i+1];
     if (_colorMode == ColorMode::solid) {
       _dl->quad2(v0, v1, v2, v3);
     } else {
@@ -729,10 +1185,64 @@ void DrawContext2D::_arc(
                   {v2.x, v2.y, pointColor(v2)},
                   {v3.x, v3.y, pointColor(v3)});
     }
+  }
+}
+
+void DrawContext2D::_shapeRectangle(
+  float x, float y, float w, float h, float r, float bw)
+{
+  const float x1 = x + w;
+  const float y1 = y + h;
+  if (_colorMode == ColorMode::solid) {
+    _dl->shapeRectangle({x, y}, {x1, y1}, r, bw);
+  } else {
+    _dl->shapeRectangleC({x, y}, {x1, y1}, r, bw,
+                         pointColor(x, y), pointColor(x1, y),
+                         pointColor(x, y1), pointColor(x1, y1));
+  }
+}
+
+void DrawContext2D::_shapeSector(
+  Vec2 center, float radius, float angle0, float angle1, float bw)
+{
+  constexpr float a90 = degToRad(90.0f);
+  constexpr float a360 = degToRad(360.0f);
+  if (angle1 - angle0 >= a360) {
+    // full circle
+    const float d = radius * 2.0f;
+    _shapeRectangle(center.x - radius, center.y - radius, d, d, radius, bw);
+    return;
+  }
+
+  // cover sector with triangles of at most 90 degrees that extend past
+  // the circle edge for anti-aliasing, straight edges are from geometry
+  const int steps = int(std::ceil((angle1 - angle0) / a90));
+  const float stepAngle = (angle1 - angle0) / float(steps);
+  const float coverR = (radius + 1.0f) / std::cos(stepAngle * .5f);
+
+  Vec2 v1{
+    center.x + (coverR * std::sin(angle0)),
+    center.y - (coverR * std::cos(angle0))};
+
+  float a = angle0;
+  for (int i = 0; i < steps; ++i) {
+    if (i == steps-1) { a = angle1; } else { a += stepAngle; }
+
+    const Vec2 v2{
+      center.x + (coverR * std::sin(a)),
+      center.y - (coverR * std::cos(a))};
+
+    if (_colorMode == ColorMode::solid) {
+      _dl->shapeTriangle2(center, radius, bw, center, v1, v2);
+    } else {
+      _dl->shapeTriangle2C(center, radius, bw,
+                           {center.x, center.y, pointColor(center)},
+                           {v1.x, v1.y, pointColor(v1)},
+                           {v2.x, v2.y, pointColor(v2)});
+    }
 
     // setup for next iteration
-    v0 = v2;
-    v1 = v3;
+    v1 = v2;
   }
 }
 
@@ -740,21 +1250,14 @@ void DrawContext2D::_arcShaded(
   Vec2 center, float radius, float angle0, float angle1, int segments,
   float arcWidth, RGBA8 innerColor, RGBA8 outerColor, RGBA8 fillColor)
 {
-  const float segmentAngle = (angle1 - angle0) / float(segments);
-  const float innerR = radius - arcWidth;
-
-  const float sa0 = std::sin(angle0), ca0 = std::cos(angle0);
-  Vec2 v0{center.x + (radius * sa0), center.y - (radius * ca0)};
-  Vec2 v1{center.x + (innerR * sa0), center.y - (innerR * ca0)};
+  if (segments < 1) { return; }
+  _unitArc(angle0, angle1, segments);
+  const Vec2* outer = _arcPoints(1, center, radius);
+  const Vec2* inner = _arcPoints(2, center, radius - arcWidth);
 
-  float a = angle0;
   for (int i = 0; i < segments; ++i) {
-    if (i == segments-1) { a = angle1; } else { a += segmentAngle; }
-
-    const float sa = std::sin(a), ca = std::cos(a);
-    const Vec2 v2{center.x + (radius * sa), center.y - (radius * ca)};
-    const Vec2 v3{center.x + (innerR * sa), center.y - (innerR * ca)};
-
+    const Vec2 v0 = outer[i], v1 = inner[i];
+    const Vec2 v2 = outer[i+1], v3 = inner[i+1];
     if (innerColor | outerColor) {
       _dl->quad2C({v0.x, v0.y, outerColor},
                   {v1.x, v1.y, innerColor},
@@ -767,10 +1270,6 @@ void DrawContext2D::_arcShaded(
                       {v3.x, v3.y, fillColor},
                       {center.x, center.y, fillColor});
     }
-
-    // setup for next iteration
-    v0 = v2;
-    v1 = v3;
   }
 }
 
@@ -778,42 +1277,31 @@ void DrawContext2D::arcShaded(
   Vec2 center, float radius, float startAngle, float endAngle,
   int segments, float arcWidth, RGBA8 startColor, RGBA8 endColor)
 {
-  if ((startColor | endColor) == 0) { return; }
+  if ((startColor | endColor) == 0 || segments < 1) { return; }
 
   fixAngles(startAngle, endAngle);
-  const float angle0 = degToRad(startAngle);
-  const float angle1 = degToRad(endAngle);
-  const float segmentAngle = (angle1 - angle0) / float(segments);
-  const float innerR = radius - arcWidth;
-
-  const float sa0 = std::sin(angle0), ca0 = std::cos(angle0);
-  Vertex2C v0{center.x + (radius * sa0), center.y - (radius * ca0), startColor};
-  Vertex2C v1{center.x + (innerR * sa0), center.y - (innerR * ca0), startColor};
+  _unitArc(degToRad(startAngle), degToRad(endAngle), segments);
+  const Vec2* outer = _arcPoints(1, center, radius);
+  const Vec2* inner = _arcPoints(2, center, radius - arcWidth);
 
   const Color full0 = unpackRGBA8(startColor);
   const Color full1 = unpackRGBA8(endColor);
 
-  float a = angle0;
+  RGBA8 c0 = startColor;
   for (int i = 0; i < segments; ++i) {
-    RGBA8 c;
+    RGBA8 c1;
     if (i == segments-1) {
-      a = angle1;
-      c = endColor;
+      c1 = endColor;
     } else {
-      a += segmentAngle;
       const float x = float(i+1) / float(segments);
-      c = packRGBA8((full0 * (1.0f-x)) + (full1 * x));
+      c1 = packRGBA8((full0 * (1.0f-x)) + (full1 * x));
     }
 
-    const float sa = std::sin(a), ca = std::cos(a);
-    const Vertex2C v2{center.x + (radius * sa), center.y - (radius * ca), c};
-    const Vertex2C v3{center.x + (innerR * sa), center.y - (innerR * ca), c};
-
-    quad(v0, v1, v2, v3);
-
-    // setup for next iteration
-    v0 = v2;
-    v1 = v3;
+    quad(Vertex2C{outer[i].x, outer[i].y, c0},
+         Vertex2C{inner[i].x, inner[i].y, c0},
+         Vertex2C{outer[i+1].x, outer[i+1].y, c1},
+         Vertex2C{inner[i+1].x, inner[i+1].y, c1});
+    c0 = c1;
   }
 }
 
@@ -826,6 +1314,10 @@ void DrawContext2D::roundedRectangle(
   const float half_w = w * .5f;
   const float half_h = h * .5f;
   const float cr = min3(curveRadius, half_w, half_h);
+  if (_sdfShapes) {
+    _shapeRectangle(x, y, w, h, std::max(cr, 0.0f), 0);
+    return;
+  }
 
   // corners
   if (curveSegments >= 1) {
@@ -939,6 +1431,11 @@ void DrawContext2D::roundedBorder(
   const float half_w = w * .5f;
   const float half_h = h * .5f;
   const float cr = min3(curveRadius, half_w, half_h);
+  if (_sdfShapes) {
+    _shapeRectangle(x, y, w, h, std::max(cr, 0.0f),
+                    std::max(borderWidth, 0.0625f));
+    return;
+  }
 
   // corners
   if (curveSegments >= 1) {
@@ -1062,26 +1559,91 @@ void DrawContext2D::roundedBorderShaded(
 
 void DrawContext2D::shape(const Rect& r, const Style& style)
 {
-  if (style.fill != Style::no_fill) {
-    switch (style.fill) {
-      default: // Style::solid
-        color(style.fillColor);
-        break;
-      case Style::hgradient:
-        hgradient(r.x, style.fillColor, r.x+r.w, style.fillColor2);
-        break;
-      case Style::vgradient:
-        vgradient(r.y, style.fillColor, r.y+r.h, style.fillColor2);
-        break;
+  if (!_shapeCache || !r) {
+    _shapeFill(r, style);
+    _shapeEdge(r, style);
+    return;
+  }
+
+  const ShapeCache::Key key{
+    r.w, r.h, style.cornerRadius,
+    style.fillColor, style.fillColor2, style.edgeColor,
+    style.cornerSegments, uint8_t(style.edge), uint8_t(style.fill),
+    _sdfShapes};
+  const ShapeCache::Entry* e = _shapeCache->find(key);
+  if (!e) {
+    // draw shape at 0,0 into new cache entry
+    ShapeCache::Entry& ne = _shapeCache->add(key);
+    DrawList* dl = std::exchange(_dl, &ne.dl);
+    const RGBA8 dataColor = std::exchange(_dataColor, 0);
+    const Rect r0{0, 0, r.w, r.h};
+    _shapeFill(r0, style);
+    const std::size_t edgeStart = ne.dl.size();
+    _shapeEdge(r0, style);
+
+    // first solid draw always sets color in recorded data (it's either
+    // the fill or edge start), position saved so it can be skipped if
+    // the color is already set when drawing
+    const Value* d = ne.dl.data();
+    if (!ne.dl.empty() && d[0].uval == CMD_color) {
+      ne.colorPos = 0;
+    } else if (edgeStart < ne.dl.size() && d[edgeStart].uval == CMD_color) {
+      ne.colorPos = edgeStart;
     }
+    ne.lastColor = _dataColor;
+    _dl = dl;
+    _dataColor = dataColor;
+    e = &ne;
+  }
 
+  const std::span<const Value> data{e->dl.data(), e->dl.size()};
+  const std::size_t pos = e->colorPos;
+  if (pos < data.size() && data[pos+1].uval == _dataColor) {
+    // skip redundant color change
+    _dl->append(data.first(pos), {r.x, r.y});
+    _dl->append(data.subspan(pos+2), {r.x, r.y});
+  } else {
+    _dl->append(data, {r.x, r.y});
+  }
+  if (e->lastColor != 0) { _dataColor = e->lastColor; }
+
+  // leave color state the same as an uncached draw
+  if (style.edge != Style::no_edge && style.edgeColor != 0) {
+    color(style.edgeColor);
+  } else if (style.fill != Style::no_fill) {
+    _shapeFillColor(r, style);
+  }
+}
+
+void DrawContext2D::_shapeFillColor(const Rect& r, const Style& style)
+{
+  switch (style.fill) {
+    default: // Style::solid
+      color(style.fillColor);
+      break;
+    case Style::hgradient:
+      hgradient(r.x, style.fillColor, r.x+r.w, style.fillColor2);
+      break;
+    case Style::vgradient:
+      vgradient(r.y, style.fillColor, r.y+r.h, style.fillColor2);
+      break;
+  }
+}
+
+void DrawContext2D::_shapeFill(const Rect& r, const Style& style)
+{
+  if (style.fill != Style::no_fill) {
+    _shapeFillColor(r, style);
     if (isLTE(style.cornerRadius, 0.0f)) {
       rectangle(r);
     } else {
       roundedRectangle(r, style.cornerRadius, style.cornerSegments);
     }
   }
+}
 
+void DrawContext2D::_shapeEdge(const Rect& r, const Style& style)
+{
   if (style.edge != Style::no_edge && style.edgeColor != 0) {
     color(style.edgeColor);
     if (isLTE(style.cornerRadius, 0.0f)) {
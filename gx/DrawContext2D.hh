@@ -4,9 +4,6 @@
 //
 
 // TODO: textured roundedRectangle()
-// TODO: lines as quads
-//   - any width supported
-//   - multi-line corner types: squared, angled, rounded
 // TODO: gradient function instead of set gradient/color points
 // TODO: arc with line segments
 
@@ -19,11 +16,16 @@
 #include "Rect.hh"
 #include "Types.hh"
 #include <string_view>
+#include <span>
+#include <vector>
 
 
 class gx::DrawContext2D
 {
  public:
+  enum class LineJoin { miter, bevel, round };
+  enum class LineCap { butt, square, round };
+
   explicit DrawContext2D(DrawList& dl) : _dl{&dl} { init(); }
 
   // Low-level data entry
@@ -50,6 +52,26 @@ class gx::DrawContext2D
   void texture(TextureID tid) {
     if (tid != _lastTexID) { _lastTexID = tid; _dl->texture(tid); } }
 
+  void quadLines(float width, LineJoin join = LineJoin::miter,
+                 LineCap cap = LineCap::butt) {
+    lineEnd(); _qlWidth = width; _qlJoin = join; _qlCap = cap; }
+    // draw lines as triangles of any width w/ joins between connected
+    // segments & end caps (width 0 to restore GL lines)
+
+  void sdfShapes(bool enable) { _sdfShapes = enable; }
+    // draw circles, arcs, rounded rects & rounded borders as single quads
+    // (or a few triangles for partial circles) with edges evaluated by
+    // the renderer's SDF shader (segment values are ignored, shaded
+    // variants are unaffected)
+
+  void shapeCache(ShapeCache* c) { _shapeCache = c; }
+    // reuse shape() geometry from cache (persists across DrawLists,
+    // nullptr to disable)
+
+  void textCache(TextLayoutCache* c) { _textCache = c; }
+    // reuse text() glyph layout from cache (persists across DrawLists,
+    // nullptr to disable)
+
   // Render state change (persists across different DrawLists)
   void lineWidth(float w) { _dl->lineWidth(w); }
 
@@ -73,16 +95,17 @@ class gx::DrawContext2D
   void clearView(RGBA8 c) { _dl->clearView(c); }
 
   // Line drawing
+  //   for quadLines(), end caps of a line are added by lineEnd() or
+  //   the next lineStart()
   void line(Vec2 a, Vec2 b);
-  void line(const Vertex2C& a, const Vertex2C& b) {
-    _dl->line2C(a, b); }
+  void line(const Vertex2C& a, const Vertex2C& b);
 
   void lineStart(Vec2 a);
-  void lineStart(const Vertex2C& a) {
-    _dl->lineStart2C(a); }
+  void lineStart(const Vertex2C& a);
   void lineTo(Vec2 a);
-  void lineTo(const Vertex2C& a) {
-    _dl->lineTo2C(a); }
+  void lineTo(const Vertex2C& a);
+  void lineEnd() {
+    if (_qlState == 2) { _quadLineEnd(); } else { _qlState = 0; } }
 
   template<class T1, class T2, class T3, class... Args>
   void line(const T1& p1, const T2& p2, const T3& p3, Args&&... args) {
@@ -90,11 +113,30 @@ class gx::DrawContext2D
     lineTo(p2);
     lineTo(p3);
     (lineTo(args),...);
+    lineEnd();
   }
 
+  void polyline(std::span<const Vec2> pts);
+  void polyline(float x0, float xStep, std::span<const float> y);
+    // y-only variant, x of point i is x0 + (i * xStep)
+    // NOTE: consecutive points in the same pixel column are reduced to the
+    //   first/min/max/last points of the column before being stored as a
+    //   single command (raster result is unchanged for 1 pixel wide lines)
+
   template<class T1, class T2, class T3, class... Args>
   void lineLoop(const T1& p1, const T2& p2, const T3& p3, Args&&... args) {
-    line(p1, p2, p3, args..., p1); }
+    lineStart(p1);
+    lineTo(p2);
+    lineTo(p3);
+    (lineTo(args),...);
+    lineTo(p1);
+    _quadLineClose();
+  }
+
+  // Path drawing
+  //   strokePath() uses current line settings (GL lines or quadLines())
+  void fillPath(const Path& p);
+  void strokePath(const Path& p);
 
   // Poly drawing
   // Triangle  Quad  Rectangle
@@ -180,9 +222,23 @@ class gx::DrawContext2D
 
  private:
   DrawList* _dl = nullptr;
+  ShapeCache* _shapeCache = nullptr;
+  TextLayoutCache* _textCache = nullptr;
 
   // general properties
   TextureID _lastTexID;
+  bool _sdfShapes;
+
+  // quad line properties
+  float _qlWidth;
+  LineJoin _qlJoin;
+  LineCap _qlCap;
+  int _qlState;                   // 0-none, 1-start point, 2-segment drawn
+  Vertex2C _qlStart, _qlLast;     // first/last line points
+  Vec2 _qlStartDir, _qlLastDir;   // first/last segment directions
+  std::vector<Vec2> _polyPts;     // decimated polyline buffer
+  std::vector<Vec2> _arcPts;      // unit & scaled circle/arc points
+  std::vector<Vertex2C> _colorPts; // gradient polyline points
 
   // color/gradient properties
   float _g0, _g1;                 // x or y gradient coords
@@ -201,6 +257,11 @@ class gx::DrawContext2D
 
   void init() {
     _lastTexID = 0;
+    _sdfShapes = false;
+    _qlWidth = 0;
+    _qlJoin = LineJoin::miter;
+    _qlCap = LineCap::butt;
+    _qlState = 0;
     _color0 = 0;
     _color1 = 0;
     _dataColor = 0;
@@ -212,15 +273,35 @@ class gx::DrawContext2D
   }
 
   void _rectangle(float x, float y, float w, float h);
+  void _polyline(std::span<const Vec2> pts);
+  void _quadLineStart(const Vertex2C& a);
+  void _quadLineTo(const Vertex2C& a);
+  void _quadLineEnd();
+  void _quadLineClose();
+  void _quadLineJoin(const Vertex2C& pt, Vec2 dir0, Vec2 dir1);
+  void _quadLineCap(const Vertex2C& pt, Vec2 dir);
+  void _quadLineFan(const Vertex2C& pt, Vec2 offset, float angle);
+  void _qlTriangle(const Vertex2C& a, const Vertex2C& b, const Vertex2C& c);
+  void _qlQuad(const Vertex2C& a, const Vertex2C& b,
+               const Vertex2C& c, const Vertex2C& d);
   void _glyph(const Glyph& g, const TextFormat& tf, Vec2 baseline,
               float altWidth = 0);
+  void _unitArc(float angle0, float angle1, int segments);
+  const Vec2* _arcPoints(int slot, Vec2 center, float radius);
   void _circleSector(
     Vec2 center, float radius, float angle0, float angle1, int segments);
   void _arc(Vec2 center, float radius, float angle0, float angle1,
             int segments, float arcWidth);
+  void _shapeRectangle(float x, float y, float w, float h,
+                       float r, float bw);
+  void _shapeSector(Vec2 center, float radius, float angle0, float angle1,
+                    float bw);
   void _arcShaded(Vec2 center, float radius, float angle0, float angle1,
                   int segments, float arcWidth,
                   RGBA8 innerColor, RGBA8 outerColor, RGBA8 fillColor);
+  void _shapeFill(const Rect& r, const Style& style);
+  void _shapeEdge(const Rect& r, const Style& style);
+  void _shapeFillColor(const Rect& r, const Style& style);
 
   [[nodiscard]] RGBA8 gradientColor(float g) const;
 
@@ -0,0 +1,100 @@
+//
+// gx/DrawList.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "DrawList.hh"
+#include "Logger.hh"
+using namespace gx;
+
+
+namespace {
+  void offsetPoints(Value* v, uint32_t count, uint32_t stride, Vec2 offset)
+  {
+    for (uint32_t i = 0; i < count; ++i, v += stride) {
+      v[0].fval += offset.x;
+      v[1].fval += offset.y;
+    }
+  }
+}
+
+void DrawList::append(std::span<const Value> data, Vec2 offset)
+{
+  const size_type start = _data.size();
+  _data.insert(_data.end(), data.begin(), data.end());
+
+  Value* d = _data.data() + start;
+  Value* dEnd = _data.data() + _data.size();
+  while (d < dEnd) {
+    const uint32_t cmd = d->uval;
+    switch (cmd) {
+      case CMD_noop:         d += 1; break;
+      case CMD_framebuffer:  d += 2; break;
+      case CMD_viewport:     d += 5; break;
+      case CMD_viewportFull: d += 1; break;
+      case CMD_color:        d += 2; break;
+      case CMD_texture:      d += 2; break;
+      case CMD_normal:       d += 2; break;
+      case CMD_lineWidth:    d += 2; break;
+      case CMD_modColor:     d += 2; break;
+      case CMD_capabilities: d += 2; break;
+      case CMD_camera:       d += 33; break;
+      case CMD_light:        d += 10; break;
+      case CMD_clearView:    d += 2; break;
+      case CMD_line2:        offsetPoints(d+1, 2, 2, offset); d += 5; break;
+      case CMD_line2C:       offsetPoints(d+1, 2, 3, offset); d += 7; break;
+      case CMD_lineStart2:   offsetPoints(d+1, 1, 2, offset); d += 3; break;
+      case CMD_lineTo2:      offsetPoints(d+1, 1, 2, offset); d += 3; break;
+      case CMD_lineStart2C:  offsetPoints(d+1, 1, 3, offset); d += 4; break;
+      case CMD_lineTo2C:     offsetPoints(d+1, 1, 3, offset); d += 4; break;
+      case CMD_polyline2: {
+        const uint32_t n = d[1].uval;
+        offsetPoints(d+2, n, 2, offset); d += 2 + (n * 2); break;
+      }
+      case CMD_polyline2C: {
+        const uint32_t n = d[1].uval;
+        offsetPoints(d+2, n, 3, offset); d += 2 + (n * 3); break;
+      }
+      case CMD_triangle2:    offsetPoints(d+1, 3, 2, offset); d += 7; break;
+      case CMD_triangle2T:   offsetPoints(d+1, 3, 4, offset); d += 13; break;
+      case CMD_triangle2C:   offsetPoints(d+1, 3, 3, offset); d += 10; break;
+      case CMD_triangle2TC:  offsetPoints(d+1, 3, 5, offset); d += 16; break;
+      case CMD_quad2:        offsetPoints(d+1, 4, 2, offset); d += 9; break;
+      case CMD_quad2T:       offsetPoints(d+1, 4, 4, offset); d += 17; break;
+      case CMD_quad2C:       offsetPoints(d+1, 4, 3, offset); d += 13; break;
+      case CMD_quad2TC:      offsetPoints(d+1, 4, 5, offset); d += 21; break;
+      case CMD_rectangle:    offsetPoints(d+1, 2, 2, offset); d += 5; break;
+      case CMD_rectangleT:   offsetPoints(d+1, 2, 4, offset); d += 9; break;
+      case CMD_shapeRectangle:
+        offsetPoints(d+1, 2, 2, offset); d += 7; break;
+      case CMD_shapeRectangleC:
+        offsetPoints(d+1, 2, 2, offset); d += 11; break;
+      case CMD_shapeTriangle2:
+        offsetPoints(d+1, 1, 2, offset);
+        offsetPoints(d+5, 3, 2, offset); d += 11; break;
+      case CMD_shapeTriangle2C:
+        offsetPoints(d+1, 1, 2, offset);
+        offsetPoints(d+5, 3, 3, offset); d += 14; break;
+      case CMD_line3:        d += 7; break;
+      case CMD_line3C:       d += 9; break;
+      case CMD_lineStart3:   d += 4; break;
+      case CMD_lineTo3:      d += 4; break;
+      case CMD_lineStart3C:  d += 5; break;
+      case CMD_lineTo3C:     d += 5; break;
+      case CMD_triangle3:    d += 10; break;
+      case CMD_triangle3T:   d += 16; break;
+      case CMD_triangle3C:   d += 13; break;
+      case CMD_triangle3TC:  d += 19; break;
+      case CMD_quad3:        d += 13; break;
+      case CMD_quad3T:       d += 21; break;
+      case CMD_quad3C:       d += 17; break;
+      case CMD_quad3TC:      d += 25; break;
+
+      default:
+        // drop appended data from first invalid cmd
+        GX_LOG_ERROR("unknown DrawCmd value: ", cmd);
+        _data.erase(_data.begin() + (d - _data.data()), _data.end());
+        return;
+    }
+  }
+}
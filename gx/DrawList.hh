@@ -9,6 +9,7 @@
 #include "Normal.hh"
 #include "Types.hh"
 #include <vector>
+#include <span>
 
 
 namespace gx {
@@ -58,6 +59,9 @@ class gx::DrawList
 
   void append(const DrawList& dl) {
     _data.insert(_data.end(), dl.begin(), dl.end()); }
+  void append(std::span<const Value> data, Vec2 offset);
+    // append commands w/ offset added to all 2D positions
+    // (3D commands are unchanged)
 
   // raw draw commands
   void framebuffer(int32_t id) { add(CMD_framebuffer, id); }
@@ -114,6 +118,17 @@ class gx::DrawList
     add(CMD_lineStart2C, a.x, a.y, a.c); }
   void lineTo2C(const Vertex2C& a) {
     add(CMD_lineTo2C, a.x, a.y, a.c); }
+  void polyline2(std::span<const Vec2> pts) {
+    add(CMD_polyline2, uint32_t(pts.size()));
+    _data.reserve(_data.size() + (pts.size() * 2));
+    for (const Vec2& p : pts) { _data.insert(_data.end(), {p.x, p.y}); }
+  }
+  void polyline2C(std::span<const Vertex2C> pts) {
+    add(CMD_polyline2C, uint32_t(pts.size()));
+    _data.reserve(_data.size() + (pts.size() * 3));
+    for (const Vertex2C& p : pts) {
+      _data.insert(_data.end(), {p.x, p.y, p.c}); }
+  }
   void triangle2(Vec2 a, Vec2 b, Vec2 c) {
     add(CMD_triangle2, a.x, a.y, b.x, b.y, c.x, c.y); }
   void triangle2T(const Vertex2T& a, const Vertex2T& b, const Vertex2T& c) {
@@ -143,6 +158,19 @@ class gx::DrawList
   void rectangleT(const Vertex2T& a, const Vertex2T& b) {
     add(CMD_rectangleT, a.x, a.y, a.s, a.t, b.x, b.y, b.s, b.t); }
 
+  void shapeRectangle(Vec2 a, Vec2 b, float r, float bw) {
+    add(CMD_shapeRectangle, a.x, a.y, b.x, b.y, r, bw); }
+  void shapeRectangleC(Vec2 a, Vec2 b, float r, float bw,
+                       uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3) {
+    add(CMD_shapeRectangleC, a.x, a.y, b.x, b.y, r, bw, c0, c1, c2, c3); }
+  void shapeTriangle2(Vec2 center, float r, float bw, Vec2 a, Vec2 b, Vec2 c) {
+    add(CMD_shapeTriangle2, center.x, center.y, r, bw,
+        a.x, a.y, b.x, b.y, c.x, c.y); }
+  void shapeTriangle2C(Vec2 center, float r, float bw, const Vertex2C& a,
+                       const Vertex2C& b, const Vertex2C& c) {
+    add(CMD_shapeTriangle2C, center.x, center.y, r, bw,
+        a.x, a.y, a.c, b.x, b.y, b.c, c.x, c.y, c.c); }
+
   void line3(const Vec3& a, const Vec3& b) {
     add(CMD_line3, a.x, a.y, a.z, b.x, b.y, b.z); }
   void line3C(const Vertex3C& a, const Vertex3C& b) {
@@ -4,20 +4,44 @@
 //
 
 // TODO: investigate using stb_truetype.h
-// TODO: use signed distance fields for font texture
-//   - FT_RENDER_MODE_SDF available in freetype 2.11
-//   - multi-threaded rendering requires one FT_Library instance per thread
 
 #include "Font.hh"
 #include "Image.hh"
 #include "Logger.hh"
 #include "Assert.hh"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <unordered_set>
+#include <vector>
+#include <thread>
+#include <span>
+#include <fstream>
 #include <cstdlib>
+#include <cstring>
 #include <ft2build.h>
 #include <freetype/freetype.h>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define HAS_MMAP 1
+#endif
+
 using namespace gx;
 
 
+// **** Constants ****
+constexpr int LAZY_PAGE_SIZE = 1024;  // lazy mode atlas page size
+constexpr int MAX_LOAD_THREADS = 8;
+constexpr std::size_t MIN_THREAD_GLYPHS = 256;  // min glyphs per thread
+constexpr int DIRECT_INDEX_MAX = 0x10000;  // codes w/ direct index entry
+constexpr std::size_t BITMAP_BLOCK_SIZE = 65536;  // glyph bitmap arena block
+constexpr int MAX_CACHE_ATLAS_SIZE = 16384;
+
+
 static FT_Library ftLib;
 
 static void cleanupFreeType()
@@ -42,41 +66,399 @@ static bool initFreeType()
   return true;
 }
 
-static bool genGlyphs(Font& font, FT_Face face,
-                      uint32_t start = 0, uint32_t end = 0)
+static FT_GlyphSlot renderGlyph(FT_Face face, FT_UInt index)
 {
-  // read font glyph data
-  const bool hasVert = FT_HAS_VERTICAL(face);
+  if (FT_Load_Glyph(face, index, FT_LOAD_DEFAULT)) {
+    GX_LOG_ERROR("FT_Load_Glyph() failed");
+    return nullptr;
+  }
+
+  FT_GlyphSlot gs = face->glyph;
+  if (FT_Render_Glyph(gs, FT_RENDER_MODE_NORMAL)) {
+    GX_LOG_ERROR("FT_Render_Glyph() failed");
+    return nullptr;
+  }
+
+  return gs;
+}
+
+static float advanceY(FT_Face face)
+{
+  return FT_HAS_VERTICAL(face) ? (float(face->glyph->advance.y) / 64.0f) : 0;
+}
+
+// **** Signed distance field generation ****
+// (FT_RENDER_MODE_SDF is ~100x slower than rendering the normal bitmap &
+//  converting it w/ a linear time distance transform)
+namespace {
+  constexpr float EDT_INF = 1e20f;
+
+  void edt1D(float* grid, int n, int stride, float* f, int* v, float* z)
+  {
+    // 1D squared Euclidean distance transform (Felzenszwalb & Huttenlocher)
+    // - f/v/z are temp arrays of size n/n/n+1
+    v[0] = 0;
+    z[0] = -EDT_INF;
+    z[1] = EDT_INF;
+    f[0] = grid[0];
+    for (int q = 1, k = 0; q < n; ++q) {
+      f[q] = grid[q * stride];
+      float s;
+      do {
+        const int r = v[k];
+        s = ((f[q] + float(q * q)) - (f[r] + float(r * r)))
+          / float(2 * (q - r));
+      } while (s <= z[k] && --k >= 0);
+      ++k;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = EDT_INF;
+    }
+
+    for (int q = 0, k = 0; q < n; ++q) {
+      while (z[k + 1] < float(q)) { ++k; }
+      const int r = v[k];
+      grid[q * stride] = f[r] + float((q - r) * (q - r));
+    }
+  }
+
+  void makeSDF(const uint8_t* src, int width, int height, int pitch,
+               int spread, std::vector<uint8_t>& out)
+  {
+    // SDF bitmap padded by spread pixels on each side
+    // (127.5 at edge, +/-spread distance maps to 255/0)
+    // - edge pixel coverage is used as sub-pixel distance to edge
+    const int w = width + (spread * 2), h = height + (spread * 2);
+    const std::size_t size = std::size_t(w) * std::size_t(h);
+    std::vector<float> outer(size, EDT_INF), inner(size, 0.0f);
+    for (int y = 0; y < height; ++y) {
+      const uint8_t* row = src + (y * pitch);
+      float* o = outer.data() + ((y + spread) * w) + spread;
+      float* i = inner.data() + ((y + spread) * w) + spread;
+      for (int x = 0; x < width; ++x) {
+        const uint8_t a = row[x];
+        if (a == 255) {
+          o[x] = 0; i[x] = EDT_INF;
+        } else if (a > 0) {
+          const float d = .5f - (float(a) / 255.0f);
+          o[x] = (d > 0) ? d*d : 0; i[x] = (d < 0) ? d*d : 0;
+        }
+      }
+    }
+
+    const auto n = std::size_t(std::max(w, h));
+    std::vector<float> f(n), z(n + 1);
+    std::vector<int> v(n);
+    for (float* g : {outer.data(), inner.data()}) {
+      for (int x = 0; x < w; ++x) {
+        edt1D(g + x, h, w, f.data(), v.data(), z.data()); }
+      for (int y = 0; y < h; ++y) {
+        edt1D(g + (y * w), w, 1, f.data(), v.data(), z.data()); }
+    }
+
+    const float scale = 128.0f / float(spread);
+    out.resize(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      const float d = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+      out[i] = uint8_t(std::clamp(128.0f - (d * scale), 0.0f, 255.0f));
+    }
+  }
+
+  struct GlyphBitmap {
+    const uint8_t* data;
+    int width, height;
+    float left, top;
+  };
+
+  [[nodiscard]] GlyphBitmap glyphBitmap(
+    FT_GlyphSlot gs, bool sdf, std::vector<uint8_t>& buffer)
+  {
+    // rendered glyph bitmap (converted to SDF in buffer if sdf is set)
+    const int w = int(gs->bitmap.width), h = int(gs->bitmap.rows);
+    const auto left = float(gs->bitmap_left), top = float(gs->bitmap_top);
+    if (!sdf || w == 0 || h == 0) {
+      return {gs->bitmap.buffer, w, h, left, top};
+    }
+
+    constexpr int s = Font::SDF_SPREAD;
+    makeSDF(gs->bitmap.buffer, w, h, gs->bitmap.pitch, s, buffer);
+    return {buffer.data(), w + (s * 2), h + (s * 2),
+            left - float(s), top + float(s)};
+  }
+}
+
+
+// **** Glyph rendering ****
+namespace {
+  struct CharIndex { FT_ULong code; FT_UInt index; };
+
+  struct GlyphRender {
+    int code, width, height;
+    float left, top, advX, advY;
+    std::size_t offset;  // bitmap start in GlyphBatch::bitmaps
+  };
+
+  struct GlyphBatch {
+    std::vector<GlyphRender> glyphs;
+    std::vector<uint8_t> bitmaps;
+    bool status = false;
+  };
+}
+
+static bool renderGlyphs(FT_Face face, std::span<const CharIndex> chars,
+                         bool sdf, GlyphBatch& out)
+{
+  std::vector<uint8_t> sdfBuffer;
+  out.glyphs.reserve(chars.size());
+  for (const auto [code,index] : chars) {
+    FT_GlyphSlot gs = renderGlyph(face, index);
+    if (!gs) { return false; }
+
+    const GlyphBitmap b = glyphBitmap(gs, sdf, sdfBuffer);
+    out.glyphs.push_back({int(code), b.width, b.height, b.left, b.top,
+                          float(gs->advance.x) / 64.0f, advanceY(face),
+                          out.bitmaps.size()});
+    if (b.data) {
+      out.bitmaps.insert(out.bitmaps.end(), b.data,
+                         b.data + (b.width * b.height));
+    }
+  }
+  return true;
+}
+
+static void renderGlyphsThread(
+  const char* fileName, const void* mem, std::size_t memSize, int size,
+  bool sdf, std::span<const CharIndex> chars, GlyphBatch& out)
+{
+  // FreeType library objects can't be shared between threads so each
+  // thread has its own library instance & face
+  FT_Library lib;
+  if (FT_Init_FreeType(&lib)) {
+    GX_LOG_ERROR("FT_Init_FreeType() failed");
+    return;
+  }
+
+  FT_Face face;
+  const FT_Error err = fileName
+    ? FT_New_Face(lib, fileName, 0, &face)
+    : FT_New_Memory_Face(lib, static_cast<const FT_Byte*>(mem),
+                         FT_Long(memSize), 0, &face);
+  if (err) {
+    GX_LOG_ERROR("FT_New_Face() failed for load thread");
+  } else {
+    out.status = !FT_Set_Pixel_Sizes(face, 0, FT_UInt(size))
+      && renderGlyphs(face, chars, sdf, out);
+    FT_Done_Face(face);
+  }
+  FT_Done_FreeType(lib);
+}
+
+static bool genGlyphs(Font& font, FT_Face face, int threads,
+                      const char* fileName, const void* mem,
+                      std::size_t memSize, uint32_t start = 0, uint32_t end = 0)
+{
+  // get font glyph indices
+  std::vector<CharIndex> chars;
   FT_UInt index = 0;
   FT_ULong ch = FT_Get_First_Char(face, &index);
 
   for (; index != 0; ch = FT_Get_Next_Char(face, ch, &index)) {
     if (ch < 32 || ch < start) { continue; }
     else if (end != 0 && ch > end) { break; }
+    chars.push_back({ch, index});
+  }
 
-    if (FT_Load_Glyph(face, index, FT_LOAD_DEFAULT)) {
-      GX_LOG_ERROR("FT_Load_Glyph() failed");
-      return false;
+  // render glyphs, code ranges split between threads for large fonts
+  // (1st range is rendered on calling thread w/ already loaded face)
+  if (threads <= 0) {
+    threads = std::clamp(
+      int(std::thread::hardware_concurrency()), 1, MAX_LOAD_THREADS);
+  }
+  threads = std::clamp(
+    int(chars.size() / MIN_THREAD_GLYPHS), 1, threads);
+
+  std::vector<GlyphBatch> batches(static_cast<std::size_t>(threads));
+  std::vector<std::thread> workers;
+  const std::size_t perThread = (chars.size() + batches.size() - 1)
+    / batches.size();
+  const std::span<const CharIndex> all{chars};
+  for (std::size_t i = 1; i < batches.size(); ++i) {
+    const std::size_t first = i * perThread;
+    const auto range =
+      all.subspan(first, std::min(perThread, chars.size() - first));
+    workers.emplace_back(renderGlyphsThread, fileName, mem, memSize,
+                         font.size(), font.sdf(), range,
+                         std::ref(batches[i]));
+  }
+
+  batches[0].status =
+    renderGlyphs(face, all.first(std::min(perThread, chars.size())),
+                 font.sdf(), batches[0]);
+  for (std::thread& t : workers) { t.join(); }
+
+  // discard all glyphs if any batch failed (font isn't partially loaded)
+  for (const GlyphBatch& b : batches) {
+    if (!b.status) { return false; }
+  }
+
+  for (const GlyphBatch& b : batches) {
+    for (const GlyphRender& g : b.glyphs) {
+      font.addGlyph(g.code, g.width, g.height, g.left, g.top, g.advX, g.advY,
+                    b.bitmaps.data() + g.offset, true);
+    }
+  }
+  return true;
+}
+
+
+// **** Cache file support ****
+namespace {
+  // read-only file data
+  // (file is read into memory if mmap() isn't available)
+  class MappedFile
+  {
+   public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    // prevent copy/move
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* fileName);
+    void close();
+
+    [[nodiscard]] const uint8_t* data() const { return _data; }
+    [[nodiscard]] std::size_t size() const { return _size; }
+
+   private:
+    const uint8_t* _data = nullptr;
+    std::size_t _size = 0;
+#ifndef HAS_MMAP
+    std::unique_ptr<uint8_t[]> _buffer;
+#endif
+  };
+
+  bool MappedFile::open(const char* fileName)
+  {
+    close();
+#ifdef HAS_MMAP
+    const int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) { return false; }
+
+    struct stat st{};
+    void* ptr = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      ptr = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE,
+                   fd, 0);
     }
+    ::close(fd);
+    if (ptr == MAP_FAILED) { return false; }
+
+    _data = static_cast<const uint8_t*>(ptr);
+    _size = std::size_t(st.st_size);
+#else
+    std::ifstream fs{fileName, std::ios_base::binary | std::ios_base::ate};
+    if (!fs) { return false; }
 
-    FT_GlyphSlot gs = face->glyph;
-    if (FT_Render_Glyph(gs, FT_RENDER_MODE_NORMAL)) {
-      GX_LOG_ERROR("FT_Render_Glyph() failed");
+    const auto size = std::streamoff(fs.tellg());
+    if (size <= 0) { return false; }
+
+    _buffer = std::make_unique_for_overwrite<uint8_t[]>(std::size_t(size));
+    fs.seekg(0);
+    if (!fs.read(reinterpret_cast<char*>(_buffer.get()), size)) {
+      _buffer.reset();
       return false;
     }
 
-    const float advX = float(gs->advance.x) / 64.0f;
-    const float advY = hasVert ? (float(gs->advance.y) / 64.0f) : 0;
-    font.addGlyph(int(ch), int(gs->bitmap.width), int(gs->bitmap.rows),
-                  float(gs->bitmap_left), float(gs->bitmap_top),
-                  advX, advY, gs->bitmap.buffer, true);
+    _data = _buffer.get();
+    _size = std::size_t(size);
+#endif
+    return true;
   }
 
-  return true;
+  void MappedFile::close()
+  {
+#ifdef HAS_MMAP
+    if (_data) { ::munmap(const_cast<uint8_t*>(_data), _size); }
+#else
+    _buffer.reset();
+#endif
+    _data = nullptr;
+    _size = 0;
+  }
+
+  [[nodiscard]] uint64_t hashData(const uint8_t* data, std::size_t size)
+  {
+    // FNV-1a
+    uint64_t h = 0xcbf29ce484222325;
+    for (const uint8_t* end = data + size; data != end; ++data) {
+      h = (h ^ *data) * 0x100000001b3;
+    }
+    return h;
+  }
+
+  // cache file format (native byte order):
+  //   CacheHeader, CacheGlyph[glyphs], atlas pixels (1 byte/pixel)
+  constexpr char CACHE_MAGIC[4] = {'G','X','F','C'};
+  constexpr uint32_t CACHE_VERSION = 2;
+
+  struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;  // hash of font file data
+    int32_t fontSize, glyphs, atlasWidth, atlasHeight;
+    int32_t sdf;          // SDF glyphs if non-zero
+  };
+
+  struct CacheGlyph {
+    int32_t code;
+    uint16_t width, height, x, y;  // bitmap size & atlas position
+    float left, top, advX, advY;
+  };
 }
 
 
+// **** Font::PackedAtlas struct ****
+struct Font::PackedAtlas
+{
+  MappedFile file;  // cache file (not used for static data)
+  Image atlas;      // view of atlas pixels
+};
+
+
+// **** Font::LazyData struct ****
+struct Font::LazyData
+{
+  FT_Face face;
+  std::unordered_set<int> missing;   // codes not in font
+  Renderer* ren = nullptr;           // set by makeAtlas()
+  std::vector<TextureHandle> pages;  // atlas pages (1st is also _atlas)
+  TextureID pageTex = 0;             // current atlas page
+  int pageSize = 0;
+  AtlasPacker packer;                // current page packing state
+
+  explicit LazyData(FT_Face f) : face{f} { }
+  ~LazyData() {
+    // FreeType cleanup at exit also frees faces
+    if (ftLib) { FT_Done_Face(face); }
+  }
+};
+
+
 // **** Font class ****
+uint64_t Font::Serial::next()
+{
+  static std::atomic<uint64_t> lastSerial{0};
+  return ++lastSerial;
+}
+
+Font::Font() = default;
+Font::Font(int fontSize) : _size{fontSize} { }
+Font::~Font() = default;
+Font::Font(Font&&) noexcept = default;
+Font& Font::operator=(Font&&) noexcept = default;
+
 bool Font::load(const char* fileName)
 {
   GX_ASSERT(fileName != nullptr);
@@ -90,17 +472,12 @@ bool Font::load(const char* fileName)
     return false;
   }
 
-  if (FT_Set_Pixel_Sizes(face, 0, FT_UInt(_size))) {
-    GX_LOG_ERROR("FT_Set_Pixel_Sizes(", _size, ") failed");
-    FT_Done_Face(face);
-    return false;
-  }
+  if (!loadFace(face, fileName, nullptr, 0)) { return false; }
 
-  // read font glyph data
-  const bool status = genGlyphs(*this, face);
-  FT_Done_Face(face);
-  calcAttributes();
-  return status;
+  // font data hash for saveCache() is computed when needed
+  _sourceFile = fileName;
+  _sourceHash = 0;
+  return true;
 }
 
 bool Font::loadFromMemory(const void* mem, std::size_t memSize)
@@ -115,6 +492,19 @@ bool Font::loadFromMemory(const void* mem, std::size_t memSize)
     return false;
   }
 
+  if (!loadFace(face, nullptr, mem, memSize)) { return false; }
+
+  // memory may not be valid at saveCache(), hash now (lazy fonts can't
+  // be saved)
+  _sourceFile.clear();
+  _sourceHash = _lazy
+    ? 0 : hashData(static_cast<const uint8_t*>(mem), memSize);
+  return true;
+}
+
+bool Font::loadFace(
+  FT_Face face, const char* fileName, const void* mem, std::size_t memSize)
+{
   if (FT_Set_Pixel_Sizes(face, 0, FT_UInt(_size))) {
     GX_LOG_ERROR("FT_Set_Pixel_Sizes(", _size, ") failed");
     FT_Done_Face(face);
@@ -122,14 +512,29 @@ bool Font::loadFromMemory(const void* mem, std::size_t memSize)
   }
 
   // read font glyph data
-  const bool status = genGlyphs(*this, face);
-  FT_Done_Face(face);
+  // (lazy mode only reads ASCII glyphs to calc font attributes)
+  _lazy.reset();
+  _packed.reset();
+  _sourceFile.clear();
+  _sourceHash = 0;
+  const bool status = genGlyphs(*this, face, _lazyLoad ? 1 : _loadThreads,
+                                fileName, mem, memSize, 0,
+                                _lazyLoad ? 126 : 0);
+  if (_lazyLoad && status) {
+    _lazy = std::make_unique<LazyData>(face);
+  } else {
+    FT_Done_Face(face);
+  }
+
   calcAttributes();
   return status;
 }
 
 bool Font::loadFromData(const GlyphStaticData* data, int glyphs)
 {
+  _packed.reset();
+  _sourceFile.clear();
+  _sourceHash = 0;
   for (int i = 0; i < glyphs; ++i) {
     const auto& d = data[i];
     addGlyph(d.code, d.width, d.height, d.left, d.top, d.advX, d.advY,
@@ -140,52 +545,266 @@ bool Font::loadFromData(const GlyphStaticData* data, int glyphs)
   return true;
 }
 
+bool Font::loadFromData(const FontStaticData& data)
+{
+  GX_ASSERT(data.atlas != nullptr);
+  if (!empty()) {
+    GX_LOG_ERROR("font data can't be loaded into a font w/ glyphs");
+    return false;
+  }
+
+  _size = data.size;
+  _sdf = data.sdf;
+  _lazy.reset();
+  _packed = std::make_unique<PackedAtlas>();
+  _packed->atlas.init(data.atlasWidth, data.atlasHeight, 1, data.atlas, false);
+  for (int i = 0; i < data.glyphCount; ++i) {
+    const GlyphStaticData& d = data.glyphs[i];
+    addPackedGlyph(d.code, d.width, d.height, d.x, d.y,
+                   d.left, d.top, d.advX, d.advY);
+  }
+
+  _sourceFile.clear();
+  _sourceHash = 0;
+  _bitmapsReleased = false;
+  calcAttributes();
+  return true;
+}
+
+void Font::addPackedGlyph(int code, int width, int height, int x, int y,
+                          float left, float top, float advX, float advY)
+{
+  // glyph w/o bitmap, image is already in packed atlas
+  Glyph& g = newGlyph(code, 0, 0, left, top, advX, advY, nullptr, false);
+  g.width = width;
+  g.height = height;
+  if (!g.empty()) {
+    const Image& atlas = _packed->atlas;
+    g.t0 = atlas.texCoord(x, y);
+    g.t1 = atlas.texCoord(x + width, y + height);
+  }
+}
+
+bool Font::loadCache(const char* cacheFile, const char* fontFile)
+{
+  GX_ASSERT(cacheFile != nullptr && fontFile != nullptr);
+  GX_ASSERT(_size != 0);
+
+  if (!empty()) {
+    GX_LOG_ERROR("font cache can't be loaded into a font w/ glyphs");
+    return false;
+  }
+
+  uint64_t hash;
+  {
+    MappedFile font;
+    if (!font.open(fontFile)) {
+      GX_LOG_ERROR("can't read font file \"", fontFile, "\"");
+      return false;
+    }
+    hash = hashData(font.data(), font.size());
+  }
+
+  auto cd = std::make_unique<PackedAtlas>();
+  if (!cd->file.open(cacheFile)) { return false; }  // no cache file
+
+  const uint8_t* data = cd->file.data();
+  CacheHeader h{};
+  if (cd->file.size() >= sizeof(h)) { std::memcpy(&h, data, sizeof(h)); }
+
+  const std::size_t pixelsStart =
+    sizeof(h) + (std::size_t(std::max(h.glyphs, 0)) * sizeof(CacheGlyph));
+  if (std::memcmp(h.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+      || h.version != CACHE_VERSION || h.sourceHash != hash
+      || h.fontSize != _size || (h.sdf != 0) != _sdf || h.glyphs < 0
+      || h.atlasWidth <= 0 || h.atlasHeight <= 0
+      || cd->file.size() != (pixelsStart
+          + (std::size_t(h.atlasWidth) * std::size_t(h.atlasHeight)))) {
+    GX_LOG_INFO("font cache \"", cacheFile, "\" is out of date");
+    return false;
+  }
+
+  // check glyph rects before any glyphs are added (font stays empty if
+  // cache is rejected, rect values are unsigned)
+  for (int i = 0; i < h.glyphs; ++i) {
+    CacheGlyph cg;
+    std::memcpy(&cg, data + sizeof(h) + (std::size_t(i) * sizeof(cg)),
+                sizeof(cg));
+    if ((cg.x + cg.width) > h.atlasWidth
+        || (cg.y + cg.height) > h.atlasHeight) {
+      GX_LOG_ERROR("font cache \"", cacheFile, "\" has invalid glyph data");
+      return false;
+    }
+  }
+
+  cd->atlas.init(h.atlasWidth, h.atlasHeight, 1, data + pixelsStart, false);
+  _lazy.reset();
+  _packed = std::move(cd);
+  for (int i = 0; i < h.glyphs; ++i) {
+    CacheGlyph cg;
+    std::memcpy(&cg, data + sizeof(h) + (std::size_t(i) * sizeof(cg)),
+                sizeof(cg));
+    addPackedGlyph(cg.code, cg.width, cg.height, cg.x, cg.y,
+                   cg.left, cg.top, cg.advX, cg.advY);
+  }
+
+  _sourceFile.clear();
+  _sourceHash = 0;  // cached fonts can't be saved
+  _bitmapsReleased = false;
+  calcAttributes();
+  return true;
+}
+
+bool Font::saveCache(const char* cacheFile) const
+{
+  GX_ASSERT(cacheFile != nullptr);
+  if (_lazy || (_sourceFile.empty() && _sourceHash == 0)) {
+    GX_LOG_ERROR("font cache needs a non-lazy font loaded from file/memory");
+    return false;
+  } else if (_packed || _bitmapsReleased) {
+    GX_LOG_ERROR("can't save font cache, glyph bitmaps not available");
+    return false;
+  }
+
+  uint64_t hash = _sourceHash;
+  if (!_sourceFile.empty()) {
+    MappedFile font;
+    if (!font.open(_sourceFile.c_str())) {
+      GX_LOG_ERROR("can't read font file \"", _sourceFile, "\"");
+      return false;
+    }
+    hash = hashData(font.data(), font.size());
+  }
+
+  std::vector<AtlasPacker::Item> items;
+  Image img;
+  if (!packAtlas(MAX_CACHE_ATLAS_SIZE, items, img)) { return false; }
+
+  CacheHeader h{};
+  std::memcpy(h.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  h.version = CACHE_VERSION;
+  h.sourceHash = hash;
+  h.fontSize = _size;
+  h.glyphs = int32_t(_glyphs.size());
+  h.atlasWidth = img.width();
+  h.atlasHeight = img.height();
+  h.sdf = _sdf ? 1 : 0;
+
+  std::vector<CacheGlyph> glyphs;
+  glyphs.reserve(_glyphs.size());
+  auto item = items.cbegin();
+  for (const Glyph& g : _glyphs) {
+    const AtlasPacker::Item& i = *item++;
+    const bool e = g.empty();
+    glyphs.push_back({g.code, uint16_t(g.width), uint16_t(g.height),
+                      uint16_t(e ? 0 : i.x), uint16_t(e ? 0 : i.y),
+                      g.left, g.top, g.advX, g.advY});
+  }
+
+  std::ofstream fs{cacheFile, std::ios_base::binary | std::ios_base::trunc};
+  fs.write(reinterpret_cast<const char*>(&h), sizeof(h));
+  fs.write(reinterpret_cast<const char*>(glyphs.data()),
+           std::streamsize(glyphs.size() * sizeof(CacheGlyph)));
+  fs.write(reinterpret_cast<const char*>(img.data()),
+           std::streamsize(img.size()));
+  fs.close();
+  if (!fs) {
+    GX_LOG_ERROR("can't write font cache \"", cacheFile, "\"");
+    return false;
+  }
+  return true;
+}
+
 bool Font::makeAtlas(Renderer& ren)
 {
-  // get font dimensions for texture creation
-  int maxW = 0, maxH = 0, totalW = 0;
-  for (const auto& itr : _glyphs) {
-    const Image& img = itr.second.bitmap;
-    maxW = std::max(maxW, img.width());
-    maxH = std::max(maxH, img.height());
-    totalW += img.width() + 1;
-  }
-
-  // calculate texture size
-  const int maxSize = ren.maxTextureSize();
-  int texW, texH;
-  int rows = 0;
-  do {
-    ++rows;
-    texW = maxW + 1 + (totalW / rows);
-    texH = ((maxH + 1) * rows) + 1;
-  } while ((texW > texH*2) || (texW > maxSize));
-
-  // round up texture size
-  if (texW & 15) { texW = (texW & ~15) + 16; }
-  if (texH & 15) { texH = (texH & ~15) + 16; }
-
-  Image img{texW, texH, 1};
-
-  int x = 1, y = 1;
-  for (auto& itr : _glyphs) {
-    Glyph& g = itr.second;
-    const int bw = g.bitmap.width();
-    if (bw == 0) {
+  if (_bitmapsReleased) {
+    GX_LOG_ERROR("can't make atlas, glyph bitmaps were released");
+    return false;
+  }
+
+  if (_packed) {
+    // upload prepacked atlas (glyph tex coords already set)
+    const Image& img = _packed->atlas;
+    if (img.width() > ren.maxTextureSize()
+        || img.height() > ren.maxTextureSize()) {
+      GX_LOG_ERROR("packed font atlas exceeds max texture size");
+      return false;
+    }
+
+    setAtlas(ren, img);
+    if (!_keepBitmaps) { releaseBitmaps(); }
+    return true;
+  }
+
+  if (_lazy) {
+    // fixed size pages w/ glyphs added as they are loaded
+    LazyData& ld = *_lazy;
+    ld.ren = &ren;
+    ld.pages.clear();
+    ld.pageTex = 0;
+    ld.pageSize = std::min(LAZY_PAGE_SIZE, ren.maxTextureSize());
+
+    bool status = true;
+    for (Glyph& g : _glyphs) { status &= addToAtlas(g); }
+    _atlas = ld.pages.empty() ? TextureHandle{} : ld.pages[0];
+    _atlasWidth = _atlasHeight = ld.pageSize;
+    if (!_keepBitmaps) { releaseBitmaps(); }
+    return status;
+  }
+
+  std::vector<AtlasPacker::Item> items;
+  Image img;
+  if (!packAtlas(ren.maxTextureSize(), items, img)) { return false; }
+
+  auto item = items.cbegin();
+  for (Glyph& g : _glyphs) {
+    const AtlasPacker::Item& i = *item++;
+    if (g.empty()) {
       g.t0 = {};
       g.t1 = {};
-      continue;
+    } else {
+      g.t0 = img.texCoord(i.x, i.y);
+      g.t1 = img.texCoord(i.x + i.width, i.y + i.height);
     }
+  }
 
-    if ((x + bw) >= texW) { x = 1; y += maxH + 1; }
+  setAtlas(ren, img);
+  if (!_keepBitmaps) { releaseBitmaps(); }
+  return true;
+}
 
-    g.t0 = img.texCoord(x, y);
-    g.t1 = img.texCoord(x + bw, y + g.bitmap.height());
+bool Font::packAtlas(int maxSize, std::vector<AtlasPacker::Item>& items,
+                     Image& img) const
+{
+  if (_packed || _bitmapsReleased) {
+    GX_LOG_ERROR("can't pack font atlas, glyph bitmaps not available");
+    return false;
+  }
+
+  // pack glyphs w/ 1 pixel gap
+  items.clear();
+  items.reserve(_glyphs.size());
+  for (const Glyph& g : _glyphs) {
+    items.push_back({g.width, g.height});
+  }
+
+  AtlasPacker packer;
+  if (!packer.packAll(items, maxSize, 1)) {
+    GX_LOG_ERROR("font glyphs don't fit in max texture size");
+    return false;
+  }
 
-    img.stamp(x, y, g.bitmap);
-    x += bw + 1;
+  img.init(packer.width(), packer.height(), 1);
+  auto item = items.cbegin();
+  for (const Glyph& g : _glyphs) {
+    const AtlasPacker::Item& i = *item++;
+    if (!g.empty()) { img.stamp(i.x, i.y, g.image()); }
   }
+  return true;
+}
 
+void Font::setAtlas(Renderer& ren, const Image& img)
+{
   const TextureParams params{
     .width = img.width(),
     .height = img.height(),
@@ -193,24 +812,127 @@ bool Font::makeAtlas(Renderer& ren)
     .minFilter = FilterType::linear,
     .magFilter = FilterType::linear,
     .wrapS = WrapType::clampToEdge,
-    .wrapT = WrapType::clampToEdge
+    .wrapT = WrapType::clampToEdge,
+    .sdf = _sdf
   };
 
   _atlas = ren.newTexture(params);
+  _sharedPages.clear();
   ren.setSubImage(_atlas.id(), 0, 0, img);
   _atlasWidth = img.width();
   _atlasHeight = img.height();
+  for (Glyph& g : _glyphs) { g.tex = _atlas.id(); }
+}
+
+int Font::atlasPages() const
+{
+  return _lazy ? int(_lazy->pages.size())
+    : (_atlas ? 1 + int(_sharedPages.size()) : 0);
+}
+
+const Glyph* Font::lazyGlyph(int code) const
+{
+  LazyData& ld = *_lazy;
+  if (code < 32 || ld.missing.count(code)) { return nullptr; }
+
+  const FT_UInt index = FT_Get_Char_Index(ld.face, FT_ULong(code));
+  FT_GlyphSlot gs = (index == 0) ? nullptr : renderGlyph(ld.face, index);
+  if (!gs) {
+    ld.missing.insert(code);
+    return nullptr;
+  }
+
+  // bitmap isn't copied if it is released after upload
+  std::vector<uint8_t> sdfBuffer;
+  const GlyphBitmap b = glyphBitmap(gs, _sdf, sdfBuffer);
+  const bool copy = _keepBitmaps || !ld.ren;
+  Glyph& g = newGlyph(code, b.width, b.height, b.left, b.top,
+                      float(gs->advance.x) / 64.0f, advanceY(ld.face),
+                      b.data, copy);
+  if (ld.ren) { addToAtlas(g); }
+  if (!copy) { g.bitmap = nullptr; }
+  return &g;
+}
+
+bool Font::addToAtlas(Glyph& g) const
+{
+  // add glyph to current atlas page (1 pixel gap between glyphs),
+  // new page is started when current page is full
+  LazyData& ld = *_lazy;
+  const int bw = g.width;
+  const int bh = g.height;
+  if (bw == 0 || bh == 0) { return true; }
+
+  const int ps = ld.pageSize;
+  if ((bw + 2) > ps || (bh + 2) > ps) {
+    GX_LOG_ERROR("glyph size ", bw, "x", bh, " too large for atlas page");
+    return false;
+  }
+
+  int x = 0, y = 0;
+  if (ld.pageTex == 0 || !ld.packer.insert(bw, bh, x, y)) {
+    const TextureParams params{
+      .width = ps,
+      .height = ps,
+      .channels = 1,
+      .minFilter = FilterType::linear,
+      .magFilter = FilterType::linear,
+      .wrapS = WrapType::clampToEdge,
+      .wrapT = WrapType::clampToEdge,
+      .clearTexture = true,
+      .sdf = _sdf
+    };
+
+    TextureHandle t = ld.ren->newTexture(params);
+    if (!t) { return false; }
+    ld.pageTex = t.id();
+    ld.pages.push_back(std::move(t));
+    ld.packer.init(ps, ps, 1);
+    ld.packer.insert(bw, bh, x, y);
+  }
+
+  const float s = 1.0f / float(ps);
+  g.tex = ld.pageTex;
+  g.t0 = {float(x) * s, float(y) * s};
+  g.t1 = {float(x + bw) * s, float(y + bh) * s};
+  ld.ren->setSubImage(ld.pageTex, x, y, g.image());
   return true;
 }
 
 void Font::addGlyph(
   int code, int width, int height, float left, float top,
   float advX, float advY, const uint8_t* bitmap, bool copy)
+{
+  newGlyph(code, width, height, left, top, advX, advY, bitmap, copy);
+  _serial.value = Serial::next();
+}
+
+Glyph& Font::newGlyph(
+  int code, int width, int height, float left, float top,
+  float advX, float advY, const uint8_t* bitmap, bool copy) const
 {
   GX_ASSERT(width >= 0 && width < 65536);
   GX_ASSERT(height >= 0 && height < 65536);
 
-  Glyph& g = _glyphs[code];
+  const uint32_t existing = glyphIndex(code);
+  Glyph* gp = (existing != 0) ? &_glyphs[existing - 1] : nullptr;
+  if (!gp) {
+    // add new glyph to storage & lookup tables
+    gp = &_glyphs.emplace_back();
+    gp->code = code;
+    const auto index = uint32_t(_glyphs.size());
+    if (code >= 0 && code < DIRECT_INDEX_MAX) {
+      if (std::size_t(code) >= _directIndex.size()) {
+        _directIndex.resize(std::size_t(code) + 1, 0);
+      }
+      _directIndex[std::size_t(code)] = index;
+    } else {
+      hashInsert(code, index);
+    }
+    if (code == _unknownCode) { _unknownGlyph = gp; }
+  }
+
+  Glyph& g = *gp;
   g.fontSize = _size;
   g.left = left;
   g.top = top;
@@ -218,8 +940,103 @@ void Font::addGlyph(
   g.advY = advY;
 
   if (bitmap && (width > 0) && (height > 0)) {
-    g.bitmap.init(width, height, 1, bitmap, copy);
+    if (copy) {
+      const auto size = std::size_t(width * height);
+      uint8_t* b = allocBitmap(size);
+      std::memcpy(b, bitmap, size);
+      g.bitmap = b;
+    } else {
+      g.bitmap = bitmap;
+    }
+    g.width = width;
+    g.height = height;
+  } else {
+    g.bitmap = nullptr;
+    g.width = 0;
+    g.height = 0;
+  }
+  return g;
+}
+
+uint8_t* Font::allocBitmap(std::size_t size) const
+{
+  if (_bitmapBlocks.empty() || size > (_blockSize - _blockUsed)) {
+    // start new block (large bitmaps get their own block)
+    _blockSize = std::max(size, BITMAP_BLOCK_SIZE);
+    _blockUsed = 0;
+    _bitmapBlocks.push_back(
+      std::make_unique_for_overwrite<uint8_t[]>(_blockSize));
+    _bitmapBytes += _blockSize;
+  }
+
+  uint8_t* b = _bitmapBlocks.back().get() + _blockUsed;
+  _blockUsed += size;
+  return b;
+}
+
+void Font::unpackBitmaps()
+{
+  // copy glyph bitmaps from packed atlas
+  // (glyph tex coords must still be for packed atlas)
+  if (!_packed) { return; }
+
+  const Image& atlas = _packed->atlas;
+  for (Glyph& g : _glyphs) {
+    if (g.empty()) { continue; }
+
+    const auto x = int(std::lround(g.t0.x * float(atlas.width())));
+    const auto y = int(std::lround(g.t0.y * float(atlas.height())));
+    uint8_t* b = allocBitmap(std::size_t(g.width) * std::size_t(g.height));
+    for (int row = 0; row < g.height; ++row) {
+      std::memcpy(b + (row * g.width),
+                  atlas.data() + ((y + row) * atlas.width()) + x,
+                  std::size_t(g.width));
+    }
+    g.bitmap = b;
+  }
+  _packed.reset();
+}
+
+void Font::releaseBitmaps()
+{
+  for (Glyph& g : _glyphs) { g.bitmap = nullptr; }
+  _bitmapBlocks.clear();
+  _blockSize = _blockUsed = 0;
+  _packed.reset();
+  _bitmapBytes = 0;
+  _bitmapsReleased = true;
+}
+
+uint32_t Font::hashFind(int code) const
+{
+  if (_hash.empty()) { return 0; }
+
+  const std::size_t mask = _hash.size() - 1;
+  for (std::size_t i = (uint32_t(code) * 2654435761u) & mask; ;
+       i = (i + 1) & mask) {
+    const HashEntry& e = _hash[i];
+    if (e.index == 0 || e.code == code) { return e.index; }
+  }
+}
+
+void Font::hashInsert(int code, uint32_t index) const
+{
+  // keep table at most half full
+  if ((_hashCount + 1) * 2 > _hash.size()) {
+    std::vector<HashEntry> old;
+    old.swap(_hash);
+    _hash.assign(std::max<std::size_t>(old.size() * 2, 64), {0, 0});
+    _hashCount = 0;
+    for (const HashEntry& e : old) {
+      if (e.index != 0) { hashInsert(e.code, e.index); }
+    }
   }
+
+  const std::size_t mask = _hash.size() - 1;
+  std::size_t i = (uint32_t(code) * 2654435761u) & mask;
+  while (_hash[i].index != 0) { i = (i + 1) & mask; }
+  _hash[i] = {code, index};
+  ++_hashCount;
 }
 
 void Font::calcAttributes()
@@ -228,16 +1045,19 @@ void Font::calcAttributes()
   _ymin = 0;
   _digitWidth = 0;
 
-  for (auto& [code,g] : _glyphs) {
+  // SDF glyph padding isn't part of glyph extents
+  const float pad = glyphPadding();
+  for (const Glyph& g : _glyphs) {
+    const int code = g.code;
     if ((code > 47 && code < 94) || (code > 96 && code < 127)) {
       // ymin/ymax adjust for a limited range of characters
-      _ymax = std::max(_ymax, g.top);
-      _ymin = std::min(_ymin, g.top - float(g.bitmap.height()));
+      _ymax = std::max(_ymax, g.top - pad);
+      _ymin = std::min(_ymin, g.top - float(g.height) + pad);
     }
 
     if (std::isdigit(code) || code == '.' || code == '-') {
       _digitWidth = std::max(
-        _digitWidth, std::max(float(g.bitmap.width()) + g.left, g.advX));
+        _digitWidth, std::max(float(g.width) + g.left - pad, g.advX));
     }
   }
 }
@@ -8,9 +8,16 @@
 #pragma once
 #include "Renderer.hh"
 #include "Glyph.hh"
+#include "AtlasPacker.hh"
 #include "Types.hh"
-#include <map>
+#include <deque>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
 
+struct FT_FaceRec_;
 
 namespace gx {
   struct GlyphStaticData {
@@ -18,25 +25,73 @@ namespace gx {
     uint16_t width, height;
     float left, top, advX, advY;
     const uint8_t* bitmap;
+    uint16_t x = 0, y = 0;  // atlas position (FontStaticData glyphs only)
+  };
+
+  struct FontStaticData {
+    int size;                      // font pixel size
+    const GlyphStaticData* glyphs; // glyphs w/o bitmaps
+    int glyphCount;
+    const uint8_t* atlas;          // prepacked atlas (1 byte per pixel)
+    int atlasWidth, atlasHeight;
+    bool sdf = false;              // SDF glyphs (see Font::setSDF())
   };
 }
 
 class gx::Font
 {
  public:
-  Font() = default;
-  explicit Font(int fontSize) : _size{fontSize} { }
+  Font();
+  explicit Font(int fontSize);
+  ~Font();
 
   // prevent copy but allow move
   Font(const Font&) = delete;
   Font& operator=(const Font&) = delete;
-  Font(Font&&) noexcept = default;
-  Font& operator=(Font&&) noexcept = default;
+  Font(Font&&) noexcept;
+  Font& operator=(Font&&) noexcept;
 
   void setSize(int s) { _size = s; }
   [[nodiscard]] int size() const { return _size; }
     // font pixel size
 
+  void setLazy(bool lazy) { _lazyLoad = lazy; }
+  [[nodiscard]] bool lazy() const { return _lazyLoad; }
+    // lazy mode (set before load/loadFromMemory):
+    // - only ASCII glyphs are rendered at load, others are rendered on
+    //   first lookup
+    // - font file stays open (memory for loadFromMemory() must stay valid)
+    // - makeAtlas() creates atlas pages that are updated as glyphs are
+    //   added (renderer must outlive font)
+
+  void setLoadThreads(int threads) { _loadThreads = threads; }
+  [[nodiscard]] int loadThreads() const { return _loadThreads; }
+    // max threads used to render glyphs at load (0 for hardware thread
+    // count, fonts w/ few glyphs use fewer threads)
+
+  void setSDF(bool sdf) { _sdf = sdf; }
+  [[nodiscard]] bool sdf() const { return _sdf; }
+    // signed distance field mode (set before load/loadFromMemory):
+    // - glyph bitmaps are distance fields padded by SDF_SPREAD pixels,
+    //   atlas is drawn w/ renderer's SDF shader
+    // - glyphs stay sharp when scaled/rotated (TextFormat::scale()), so
+    //   one loaded size can replace several sizes of the same font
+
+  static constexpr int SDF_SPREAD = 4;
+    // SDF glyph padding & max edge distance in pixels
+
+  [[nodiscard]] float glyphPadding() const {
+    return _sdf ? float(SDF_SPREAD) : 0.0f; }
+    // padding around glyph bitmaps (included in Glyph left/top/size)
+
+  void setKeepBitmaps(bool keep) { _keepBitmaps = keep; }
+  [[nodiscard]] bool keepBitmaps() const { return _keepBitmaps; }
+    // if false, glyph bitmaps are released after makeAtlas() uploads them
+    // (Glyph::bitmap is set to null, makeAtlas() can't be called again)
+
+  [[nodiscard]] std::size_t bitmapBytes() const { return _bitmapBytes; }
+    // memory allocated for glyph bitmaps
+
   bool load(const char* fileName);
     // load TTF file & render glyphs for current size
 
@@ -49,12 +104,44 @@ class gx::Font
   bool loadFromData(const GlyphStaticData* data, int glyphs);
     // load from static glyph data
 
+  bool loadFromData(const FontStaticData& data);
+    // load from prerendered font (see embed_font tool), sets font size
+    // & SDF mode
+    // (glyphs have no bitmaps, makeAtlas() uploads the prepacked atlas)
+
+  bool loadCache(const char* cacheFile, const char* fontFile);
+    // load glyph metrics & packed atlas image from file made by saveCache()
+    // - fails if cache is missing or was made w/ a different format
+    //   version, font file contents, font size or SDF mode
+    // - glyphs have no bitmaps, makeAtlas() uploads the cached atlas
+
+  bool saveCache(const char* cacheFile) const;
+    // save glyph metrics & packed atlas image
+    // (font must be loaded w/ load()/loadFromMemory() & not be lazy,
+    //  font file is read again to calc its hash)
+
+  template<class T1, class T2>
+  bool loadCache(const T1& cacheFile, const T2& fontFile) {
+    return loadCache(cacheFile.c_str(), fontFile.c_str()); }
+  template<class T>
+  bool saveCache(const T& cacheFile) const {
+    return saveCache(cacheFile.c_str()); }
+
   bool makeAtlas(Renderer& ren);
     // creates texture containing every glyph & sets glyph texture coords
+    // (in lazy mode, later glyphs are added to atlas as they are loaded)
+    // - use FontAtlas to share textures between fonts
 
   template<class T>
   bool makeAtlas(T& win) { return makeAtlas(win.renderer()); }
 
+  bool packAtlas(int maxSize, std::vector<AtlasPacker::Item>& items,
+                 Image& img) const;
+    // pack glyph bitmaps into one image w/ 1 pixel gap (same layout as
+    // makeAtlas(), items are glyph positions in glyphs() order)
+    // (fails if glyph bitmaps aren't available or image would be larger
+    //  than maxSize x maxSize)
+
   [[nodiscard]] float ymin() const { return _ymin; }
   [[nodiscard]] float ymax() const { return _ymax; }
     // min/max y values relative to origin for baseline calculation
@@ -67,38 +154,121 @@ class gx::Font
   [[nodiscard]] int atlasWidth() const { return _atlasWidth; }
   [[nodiscard]] int atlasHeight() const { return _atlasHeight; }
     // texture atlas created by engine
+    // (1st page only for lazy mode or multi-page FontAtlas, use
+    //  Glyph::tex for glyph's page)
+
+  [[nodiscard]] int atlasPages() const;
 
   [[nodiscard]] const auto& glyphs() const { return _glyphs; }
+    // all glyphs (in load order)
 
   [[nodiscard]] bool empty() const { return _glyphs.empty(); }
   [[nodiscard]] explicit operator bool() const { return !empty(); }
 
+  [[nodiscard]] uint64_t serial() const { return _serial.value; }
+    // unique value for font's glyph set (changed by addGlyph(),
+    // setUnknownCode() & moves, so cached data w/ glyph pointers can
+    // detect a different or destroyed font at the same address)
+
   [[nodiscard]] const Glyph* findGlyph(int code) const {
-    auto i = _glyphs.find(code);
-    return (i != _glyphs.end()) ? &(i->second) : nullptr;
+    const uint32_t i = glyphIndex(code);
+    return (i != 0) ? &_glyphs[i - 1] : (_lazy ? lazyGlyph(code) : nullptr);
   }
 
+  [[nodiscard]] const Glyph* findGlyphOrUnknown(int code) const {
+    const Glyph* g = findGlyph(code);
+    return g ? g : unknownGlyph();
+  }
+    // returns unknownCode() glyph if code has no glyph
+
+  [[nodiscard]] const Glyph* unknownGlyph() const {
+    return (_unknownGlyph || !_lazy) ? _unknownGlyph
+                                     : findGlyph(_unknownCode); }
+
   [[nodiscard]] float glyphWidth(int code) const {
     const Glyph* g = findGlyph(code);
-    return g ? std::max(g->advX, float(g->bitmap.width()) + g->left) : 0;
+    return g ? std::max(g->advX, float(g->width) + g->left - glyphPadding())
+             : 0;
   }
 
   void addGlyph(int code, int width, int height, float left, float top,
 		float advX, float advY, const uint8_t* bitmap, bool copy);
 
   [[nodiscard]] int32_t unknownCode() const { return _unknownCode; }
-  void setUnknownCode(int32_t uc) { _unknownCode = uc; }
+  void setUnknownCode(int32_t uc) {
+    _unknownCode = uc; _unknownGlyph = findGlyph(uc);
+    _serial.value = Serial::next(); }
     // read/set alternate glyph code to use for unknown code values
 
  private:
-  std::map<int,Glyph> _glyphs;
+  friend class FontAtlas;
+  struct LazyData;
+  struct PackedAtlas;
+
+  struct HashEntry { int32_t code; uint32_t index; };
+
+  struct Serial {
+    // new value for each font (moved from font gets a new value)
+    uint64_t value = next();
+
+    Serial() = default;
+    Serial(Serial&& s) noexcept : value{std::exchange(s.value, next())} { }
+    Serial& operator=(Serial&& s) noexcept {
+      value = std::exchange(s.value, next()); return *this; }
+    [[nodiscard]] static uint64_t next();
+  };
+
+  // glyph storage & lookup
+  // (lazy mode adds glyphs on lookup, deque keeps Glyph pointers valid)
+  mutable std::deque<Glyph> _glyphs;
+  mutable std::vector<uint32_t> _directIndex;
+    // glyph index+1 for BMP codes up to max BMP code loaded (0 if none)
+  mutable std::vector<HashEntry> _hash;
+    // open addressing table for other codes (index 0 if empty slot)
+  mutable std::size_t _hashCount = 0;
+  mutable const Glyph* _unknownGlyph = nullptr;
+
+  // glyph bitmap arena (bitmaps are packed into large blocks)
+  mutable std::vector<std::unique_ptr<uint8_t[]>> _bitmapBlocks;
+  mutable std::size_t _blockSize = 0, _blockUsed = 0;  // last block
+  mutable std::size_t _bitmapBytes = 0;
+  std::unique_ptr<LazyData> _lazy;
+  std::unique_ptr<PackedAtlas> _packed;  // from loadCache()/static data
   TextureHandle _atlas;
+  std::vector<TextureHandle> _sharedPages;  // other FontAtlas pages used
   int _atlasWidth = 0;
   int _atlasHeight = 0;
   int _size = 0;
   float _ymin = 0, _ymax = 0;
   float _digitWidth = 0;
   int32_t _unknownCode = '*';
+  int _loadThreads = 0;
+  bool _lazyLoad = false;
+  bool _keepBitmaps = true;
+  bool _bitmapsReleased = false;
+  bool _sdf = false;
+  std::string _sourceFile;   // loaded font file (hashed by saveCache())
+  uint64_t _sourceHash = 0;  // hash of loadFromMemory() data
+  Serial _serial;
 
   void calcAttributes();
+  bool loadFace(FT_FaceRec_* face, const char* fileName,
+                const void* mem, std::size_t memSize);
+  Glyph& newGlyph(int code, int width, int height, float left, float top,
+                  float advX, float advY, const uint8_t* bitmap,
+                  bool copy) const;
+  [[nodiscard]] uint32_t glyphIndex(int code) const {
+    return (uint32_t(code) < _directIndex.size())
+      ? _directIndex[std::size_t(code)] : hashFind(code); }
+    // returns glyph index+1 (0 if code isn't loaded)
+  [[nodiscard]] uint32_t hashFind(int code) const;
+  void hashInsert(int code, uint32_t index) const;
+  const Glyph* lazyGlyph(int code) const;
+  bool addToAtlas(Glyph& g) const;
+  void setAtlas(Renderer& ren, const Image& img);
+  void addPackedGlyph(int code, int width, int height, int x, int y,
+                      float left, float top, float advX, float advY);
+  [[nodiscard]] uint8_t* allocBitmap(std::size_t size) const;
+  void unpackBitmaps();
+  void releaseBitmaps();
 };
@@ -0,0 +1,161 @@
+//
+// gx/FontAtlas.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "FontAtlas.hh"
+#include "Font.hh"
+#include "AtlasPacker.hh"
+#include "Image.hh"
+#include "Logger.hh"
+#include "Assert.hh"
+#include <algorithm>
+using namespace gx;
+
+
+void FontAtlas::add(Font& font)
+{
+  if (std::find(_fonts.begin(), _fonts.end(), &font) == _fonts.end()) {
+    _fonts.push_back(&font);
+  }
+}
+
+void FontAtlas::clear()
+{
+  _fonts.clear();
+  _pages.clear();
+}
+
+bool FontAtlas::make(Renderer& ren, int maxPageSize)
+{
+  const int maxSize = (maxPageSize > 0)
+    ? std::min(maxPageSize, ren.maxTextureSize()) : ren.maxTextureSize();
+
+  for (const Font* f : _fonts) {
+    if (f->_lazy) {
+      GX_LOG_ERROR("lazy font can't use a shared atlas");
+      return false;
+    } else if (f->_bitmapsReleased) {
+      GX_LOG_ERROR("can't make shared atlas, glyph bitmaps were released");
+      return false;
+    }
+  }
+
+  _pages.clear();
+  bool status = true;
+  for (const bool sdf : {false, true}) {
+    std::vector<Glyph*> glyphs;
+    for (Font* f : _fonts) {
+      if (f->_sdf != sdf) { continue; }
+
+      // glyphs from loadCache()/static data need bitmaps to be repacked
+      f->unpackBitmaps();
+      for (Glyph& g : f->_glyphs) {
+        if (g.empty()) {
+          g.t0 = {};
+          g.t1 = {};
+        } else {
+          glyphs.push_back(&g);
+        }
+      }
+    }
+
+    if (!glyphs.empty()) { status &= makePages(ren, maxSize, sdf, glyphs); }
+  }
+
+  for (Font* f : _fonts) {
+    // font atlas is page of 1st glyph (empty glyphs also use this page)
+    const auto itr = std::find_if(f->_glyphs.begin(), f->_glyphs.end(),
+                                  [](const Glyph& g){ return !g.empty(); });
+    const TextureID tid = (itr != f->_glyphs.end()) ? itr->tex : 0;
+    std::vector<TextureID> used;
+    for (const Glyph& g : f->_glyphs) {
+      if (!g.empty() && g.tex != tid
+          && std::find(used.begin(), used.end(), g.tex) == used.end()) {
+        used.push_back(g.tex);
+      }
+    }
+
+    // font holds every page its glyphs use so atlas can be destroyed
+    f->_atlas = {};
+    f->_atlasWidth = f->_atlasHeight = 0;
+    f->_sharedPages.clear();
+    for (const Page& p : _pages) {
+      if (p.tex.id() == tid) {
+        f->_atlas = p.tex;
+        f->_atlasWidth = p.width;
+        f->_atlasHeight = p.height;
+      } else if (std::find(used.begin(), used.end(), p.tex.id())
+                 != used.end()) {
+        f->_sharedPages.push_back(p.tex);
+      }
+    }
+
+    for (Glyph& g : f->_glyphs) {
+      if (g.empty()) { g.tex = tid; }
+    }
+    if (!f->_keepBitmaps) { f->releaseBitmaps(); }
+  }
+  return status;
+}
+
+bool FontAtlas::makePages(Renderer& ren, int maxSize, bool sdf,
+                          std::vector<Glyph*>& glyphs)
+{
+  // pack as many glyphs as possible in each page (last page is sized to
+  // fit remaining glyphs), 1 pixel gap between glyphs
+  std::vector<AtlasPacker::Item> items;
+  std::vector<Glyph*> next;
+  while (!glyphs.empty()) {
+    items.clear();
+    items.reserve(glyphs.size());
+    for (const Glyph* g : glyphs) { items.push_back({g->width, g->height}); }
+
+    AtlasPacker packer;
+    int height;
+    if (packer.packAll(items, maxSize, 1)) {
+      height = packer.height();
+    } else {
+      // full page width, height trimmed to glyphs that fit
+      packer.init(maxSize, maxSize, 1);
+      packer.pack(items);
+      height = std::min((packer.usedHeight() + 15) & ~15, maxSize);
+      if (height <= 0) {
+        GX_LOG_ERROR("font glyphs don't fit in max atlas page size");
+        return false;
+      }
+    }
+
+    Image img{packer.width(), height, 1};
+    const TextureParams params{
+      .width = img.width(),
+      .height = img.height(),
+      .channels = 1,
+      .minFilter = FilterType::linear,
+      .magFilter = FilterType::linear,
+      .wrapS = WrapType::clampToEdge,
+      .wrapT = WrapType::clampToEdge,
+      .sdf = sdf
+    };
+
+    TextureHandle tex = ren.newTexture(params);
+    if (!tex) { return false; }
+
+    next.clear();
+    auto item = items.cbegin();
+    for (Glyph* g : glyphs) {
+      const AtlasPacker::Item& i = *item++;
+      if (!i.packed()) { next.push_back(g); continue; }
+
+      img.stamp(i.x, i.y, g->image());
+      g->tex = tex.id();
+      g->t0 = img.texCoord(i.x, i.y);
+      g->t1 = img.texCoord(i.x + i.width, i.y + i.height);
+    }
+
+    ren.setSubImage(tex.id(), 0, 0, img);
+    _pages.push_back({std::move(tex), img.width(), img.height()});
+    glyphs.swap(next);
+  }
+  return true;
+}
@@ -0,0 +1,65 @@
+//
+// gx/FontAtlas.hh
+// Copyright (C) 2026 Richard Bradley
+//
+// Texture atlas pages shared by multiple fonts
+// - glyphs of all fonts (any face/size) are packed into the same pages so
+//   text in different fonts is drawn w/o texture changes
+// - SDF & normal fonts use separate pages (drawn w/ different shaders)
+//
+
+#pragma once
+#include "Renderer.hh"
+#include "Types.hh"
+#include <vector>
+
+
+class gx::FontAtlas
+{
+ public:
+  FontAtlas() = default;
+
+  // prevent copy but allow move
+  FontAtlas(const FontAtlas&) = delete;
+  FontAtlas& operator=(const FontAtlas&) = delete;
+  FontAtlas(FontAtlas&&) noexcept = default;
+  FontAtlas& operator=(FontAtlas&&) noexcept = default;
+
+  void add(Font& font);
+    // add loaded font (font must outlive atlas, lazy fonts not supported)
+  void clear();
+
+  [[nodiscard]] const std::vector<Font*>& fonts() const { return _fonts; }
+
+  bool make(Renderer& ren, int maxPageSize = 0);
+    // pack glyphs of all fonts into shared textures & set glyph texture
+    // coords (replaces atlas from Font::makeAtlas())
+    // - glyphs that don't fit in one page of maxPageSize (renderer max
+    //   texture size if 0) are put in additional pages
+    // - bitmaps of fonts w/ keepBitmaps() false are released
+    // - fonts hold the pages their glyphs use (atlas can be destroyed)
+
+  template<class T>
+  bool make(T& win, int maxPageSize = 0) {
+    return make(win.renderer(), maxPageSize); }
+
+  [[nodiscard]] int pages() const { return int(_pages.size()); }
+  [[nodiscard]] const TextureHandle& page(int i) const {
+    return _pages[std::size_t(i)].tex; }
+  [[nodiscard]] int pageWidth(int i) const {
+    return _pages[std::size_t(i)].width; }
+  [[nodiscard]] int pageHeight(int i) const {
+    return _pages[std::size_t(i)].height; }
+
+ private:
+  struct Page {
+    TextureHandle tex;
+    int width, height;
+  };
+
+  std::vector<Font*> _fonts;
+  std::vector<Page> _pages;
+
+  bool makePages(Renderer& ren, int maxSize, bool sdf,
+                 std::vector<Glyph*>& glyphs);
+};
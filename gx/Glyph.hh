@@ -7,15 +7,25 @@
 
 #pragma once
 #include "Image.hh"
+#include "Renderer.hh"
 #include "Types.hh"
 
 
 struct gx::Glyph
 {
-  Image bitmap;
+  const uint8_t* bitmap;  // 8-bit alpha image (null if empty or released)
+  int width, height;      // bitmap size
+  int code;          // unicode value
   int fontSize;
   float left;        // # pixels at left of image
   float top;         // # pixels above baseline for image top
   float advX, advY;  // x/y cursor advancement
   Vec2 t0, t1;       // texture atlas coords
+  TextureID tex = 0; // texture atlas (page) containing glyph
+
+  [[nodiscard]] bool empty() const { return width == 0 || height == 0; }
+    // true for glyphs w/o a visible image (space)
+  [[nodiscard]] Image image() const {
+    return {width, height, 1, bitmap, false}; }
+    // image view of bitmap (bitmap must be set)
 };
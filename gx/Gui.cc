@@ -14,7 +14,9 @@
 #include "Logger.hh"
 #include "Assert.hh"
 #include "Print.hh"
+#include "Time.hh"
 #include <algorithm>
+#include <cmath>
 using namespace gx;
 
 
@@ -43,10 +45,12 @@ using namespace gx;
   }
 }
 
-static void deactivate(GuiElem& def)
+static bool deactivate(GuiElem& def)
 {
+  bool changed = def._active;
   def._active = false;
-  for (GuiElem& e : def.elems) { deactivate(e); }
+  for (GuiElem& e : def.children()) { changed |= deactivate(e); }
+  return changed;
 }
 
 static bool activate(GuiElem& def, ElemID id)
@@ -55,7 +59,7 @@ static bool activate(GuiElem& def, ElemID id)
     def._active = true;
   } else {
     // activate parent if child is activated to handle nested menus
-    for (GuiElem& e : def.elems) { def._active |= activate(e, id); }
+    for (GuiElem& e : def.children()) { def._active |= activate(e, id); }
   }
   return def._active;
 }
@@ -64,10 +68,31 @@ static int allElemState(GuiElem& def, bool enable)
 {
   int count = 0;
   if (def.eid != 0) { def._enabled = enable; ++count; }
-  for (GuiElem& e : def.elems) { count += allElemState(e, enable); }
+  for (GuiElem& e : def.children()) { count += allElemState(e, enable); }
   return count;
 }
 
+[[nodiscard]] static std::size_t countElems(const GuiElem& def)
+{
+  // NOTE: doesn't include def
+  std::size_t count = def.elems.size();
+  for (const GuiElem& e : def.elems) { count += countElems(e); }
+  return count;
+}
+
+static void flattenElems(std::vector<GuiElem>& elems, GuiElem& def)
+{
+  // move child element tree to panel storage (capacity already reserved
+  // so element pointers stay valid)
+  GX_ASSERT(elems.capacity() >= elems.size() + def.elems.size());
+  const std::size_t start = elems.size();
+  for (GuiElem& e : def.elems) { elems.push_back(std::move(e)); }
+  def._children = elems.data() + start;
+  def._childCount = uint32_t(def.elems.size());
+  def.elems = {};
+  for (GuiElem& e : def.children()) { flattenElems(elems, e); }
+}
+
 [[nodiscard]] static constexpr bool isItemType(GuiElemType type)
 {
   return (type == GUI_MENU_ITEM) || (type == GUI_LISTSELECT_ITEM);
@@ -90,14 +115,14 @@ static int allElemState(GuiElem& def, bool enable)
 
       if (def.contains(x, y)) { return &def; }
       else if (def._active) {
-        GuiElem* e = findElemByXY(def.elems[1], x, y, GUI_NULL);
+        GuiElem* e = findElemByXY(def.children()[1], x, y, GUI_NULL);
         if (e) { return e; }
       }
     }
   } else if (popupType == GUI_NULL && canSelect(def) && def.contains(x, y)) {
     return &def;
   } else {
-    for (GuiElem& c : def.elems) {
+    for (GuiElem& c : def.children()) {
       GuiElem* e = findElemByXY(c, x, y, popupType);
       if (e) { return e; }
     }
@@ -108,6 +133,17 @@ static int allElemState(GuiElem& def, bool enable)
   return nullptr;
 }
 
+static void addHitElems(GuiElem& def, std::vector<GuiElem*>& list)
+{
+  // add elements findElemByXY() can return with no active popup
+  // (in search order)
+  if (hasPopup(def.type) || canSelect(def)) {
+    list.push_back(&def);
+  } else {
+    for (GuiElem& c : def.children()) { addHitElems(c, list); }
+  }
+}
+
 template<class T>
 [[nodiscard]] static inline T* findByElemID(T& root, ElemID id)
 {
@@ -116,7 +152,7 @@ template<class T>
 
   T* e = &root;
   while (e->_id != id) {
-    for (T& c : e->elems) { stack.push_back(&c); }
+    for (T& c : e->children()) { stack.push_back(&c); }
     if (stack.empty()) { return nullptr; }
 
     e = stack.back();
@@ -125,22 +161,20 @@ template<class T>
   return e;
 }
 
-template<class T>
-[[nodiscard]] static inline T* findByEventID(T& root, EventID eid)
+template<class Fn>
+static void forEachElem(GuiElem& root, const Fn& fn)
 {
-  GX_ASSERT(eid != 0);
-  std::vector<T*> stack;
+  // visit order matches findByElemID()
+  std::vector<GuiElem*> stack;
   stack.reserve(16);
+  stack.push_back(&root);
 
-  T* e = &root;
-  while (e->eid != eid) {
-    for (T& c : e->elems) { stack.push_back(&c); }
-    if (stack.empty()) { return nullptr; }
-
-    e = stack.back();
+  while (!stack.empty()) {
+    GuiElem* e = stack.back();
     stack.pop_back();
+    fn(*e);
+    for (GuiElem& c : e->children()) { stack.push_back(&c); }
   }
-  return e;
 }
 
 [[nodiscard]] static GuiElem* findNextElem(
@@ -159,7 +193,7 @@ template<class T>
       if (!first || e->eid < first->eid) { first = e; }
     }
 
-    for (GuiElem& c : e->elems) { stack.push_back(&c); }
+    for (GuiElem& c : e->children()) { stack.push_back(&c); }
     if (stack.empty()) { return next ? next : first; }
 
     e = stack.back();
@@ -183,7 +217,7 @@ template<class T>
       if (!last || e->eid > last->eid) { last = e; }
     }
 
-    for (GuiElem& c : e->elems) { stack.push_back(&c); }
+    for (GuiElem& c : e->children()) { stack.push_back(&c); }
     if (stack.empty()) { return prev ? prev : last; }
 
     e = stack.back();
@@ -194,10 +228,10 @@ template<class T>
 [[nodiscard]] static GuiElem* findItem(GuiElem& root, int no)
 {
   // NOTE: skips root in search
-  for (GuiElem& e : root.elems) {
+  for (GuiElem& e : root.children()) {
     if (isItemType(e.type) && (no == 0 || e.item().no == no)) {
       return &e;
-    } else if (!e.elems.empty()) {
+    } else if (!e.children().empty()) {
       GuiElem* e2 = findItem(e, no);
       if (e2) { return e2; }
     }
@@ -209,11 +243,11 @@ template<class T>
 {
   // NOTE: skips root in search
   // NOTE: assumes 'id' is of an elem in a MENU or LISTSELECT
-  for (GuiElem& e : root.elems) {
+  for (GuiElem& e : root.children()) {
     if ((e.type == GUI_MENU || e.type == GUI_LISTSELECT)
-        && findByElemID(e.elems[1], id)) {
+        && findByElemID(e.children()[1], id)) {
       return &e;
-    } else if (!hasPopup(e.type) && !e.elems.empty()) {
+    } else if (!hasPopup(e.type) && !e.children().empty()) {
       GuiElem* e2 = findItemParent(e, id);
       if (e2) { return e2; }
     }
@@ -233,20 +267,91 @@ template<class T>
   }
 }
 
+[[nodiscard]] static float listRowHeight(const GuiTheme& thm)
+{
+  return float(thm.font->size() + thm.textSpacing);
+}
+
+[[nodiscard]] static Rect listArea(const GuiElem& def, const GuiTheme& thm)
+{
+  // list row area relative to panel (scrollbar is right of area)
+  const float b = thm.border;
+  return {def._x + b, def._y + b,
+          def._w - (b*2) - thm.listScrollbarWidth, def._h - (b*2)};
+}
+
+[[nodiscard]] static float listMaxScroll(
+  const GuiElem& def, const GuiTheme& thm)
+{
+  const float totalH = float(def.list().rows) * listRowHeight(thm);
+  return std::max(totalH - listArea(def, thm).h, 0.0f);
+}
+
+[[nodiscard]] static float listThumbHeight(
+  const GuiElem& def, const GuiTheme& thm)
+{
+  const float totalH = float(def.list().rows) * listRowHeight(thm);
+  const float areaH = listArea(def, thm).h;
+  return std::max(areaH * (areaH / totalH), float(thm.listScrollbarWidth));
+}
+
+[[nodiscard]] static Rect textEditArea(
+  const GuiElem& def, const GuiTheme& thm)
+{
+  // text line area relative to panel (scrollbar is right of area)
+  return {def._x + thm.entryLeftMargin, def._y + thm.entryTopMargin,
+          def._w - thm.entryLeftMargin - thm.entryRightMargin
+          - thm.listScrollbarWidth,
+          def._h - thm.entryTopMargin - thm.entryBottomMargin};
+}
+
+[[nodiscard]] static float textEditMaxScroll(
+  const GuiElem& def, const GuiTheme& thm)
+{
+  const float totalH =
+    float(def.textEdit().text.lines()) * listRowHeight(thm);
+  return std::max(totalH - textEditArea(def, thm).h, 0.0f);
+}
+
+[[nodiscard]] static float textEditThumbHeight(
+  const GuiElem& def, const GuiTheme& thm)
+{
+  const float totalH =
+    float(def.textEdit().text.lines()) * listRowHeight(thm);
+  const float areaH = textEditArea(def, thm).h;
+  return std::max(areaH * (areaH / totalH), float(thm.listScrollbarWidth));
+}
+
+[[nodiscard]] static std::size_t textEditPos(
+  const GuiElem& def, const GuiTheme& thm, float x, float y,
+  std::string& lineBuf)
+{
+  // text position for point relative to text area (only line at point
+  // is fetched & measured)
+  const TextBuffer& tb = def.textEdit().text;
+  const float line = std::floor(
+    (y + def.textEdit().scroll) / listRowHeight(thm));
+  const std::size_t l = std::size_t(
+    std::clamp(line, 0.0f, float(tb.lines() - 1)));
+  tb.getLine(l, lineBuf);
+  const TextFormat tf{.font = thm.font, .lineSpacing = float(thm.textSpacing)};
+  return tb.lineStart(l) + tf.fitText(lineBuf, x + 1).size();
+}
+
 static void resizedElem(const GuiTheme& thm, GuiElem& def)
 {
   // update children element sizes based on parent resize
   // (usually because of justify alignment)
   switch (def.type) {
     case GUI_HFRAME:
-      for (GuiElem& e : def.elems) {
+      for (GuiElem& e : def.children()) {
         if (vjustified(e.align)) {
           e._h = def._h - e.marginH(); resizedElem(thm, e);
         }
       }
       break;
     case GUI_VFRAME:
-      for (GuiElem& e : def.elems) {
+      for (GuiElem& e : def.children()) {
         if (hjustified(e.align)) {
           e._w = def._w - e.marginW(); resizedElem(thm, e);
         }
@@ -254,7 +359,7 @@ static void resizedElem(const GuiTheme& thm, GuiElem& def)
       break;
     case GUI_PANEL:
     case GUI_POPUP: {
-      GuiElem& e = def.elems[0];
+      GuiElem& e = def.children()[0];
       const float b2 = borderVal(thm, def.type) * 2;
       e._w = def._w - b2 - e.marginW();
       e._h = def._h - b2 - e.marginH();
@@ -263,7 +368,7 @@ static void resizedElem(const GuiTheme& thm, GuiElem& def)
     }
     case GUI_LISTSELECT: {
       // listselect popup list width
-      GuiElem& e1 = def.elems[1]; // GUI_POPUP
+      GuiElem& e1 = def.children()[1]; // GUI_POPUP
       e1._w = def._w + (thm.popupBorder * 2.0f) - e1.marginW();
       resizedElem(thm, e1);
       break;
@@ -273,20 +378,18 @@ static void resizedElem(const GuiTheme& thm, GuiElem& def)
   }
 }
 
-static void updateSize(GuiElem& def, const GuiTheme& thm)
+static void calcSize(GuiElem& def, const GuiTheme& thm)
 {
-  // calculate child sizes before parent
-  for (GuiElem& e : def.elems) { updateSize(e, thm); }
-
+  // calculate element size (child element sizes must already be set)
   switch (def.type) {
     case GUI_HFRAME: {
       float max_w = 0, max_h = 0;
-      for (const GuiElem& e : def.elems) {
+      for (const GuiElem& e : def.children()) {
         max_w = std::max(max_w, e.layoutW());
         max_h = std::max(max_h, e.layoutH());
       }
       float total_w = -thm.frameSpacing;
-      for (GuiElem& e : def.elems) {
+      for (GuiElem& e : def.children()) {
         if (justified(e.align)) {
           if (hjustified(e.align)) { e._w = max_w - e.marginW(); }
           if (vjustified(e.align)) { e._h = max_h - e.marginH(); }
@@ -300,12 +403,12 @@ static void updateSize(GuiElem& def, const GuiTheme& thm)
     }
     case GUI_VFRAME: {
       float max_w = 0, max_h = 0;
-      for (const GuiElem& e : def.elems) {
+      for (const GuiElem& e : def.children()) {
         max_w = std::max(max_w, e.layoutW());
         max_h = std::max(max_h, e.layoutH());
       }
       float total_h = -thm.frameSpacing;
-      for (GuiElem& e : def.elems) {
+      for (GuiElem& e : def.children()) {
         if (justified(e.align)) {
           if (hjustified(e.align)) { e._w = max_w - e.marginW(); }
           if (vjustified(e.align)) { e._h = max_h - e.marginH(); }
@@ -346,7 +449,7 @@ static void updateSize(GuiElem& def, const GuiTheme& thm)
       def._h = float(thm.font->size() - 1);
       break;
     case GUI_CHECKBOX: {
-      const GuiElem& e = def.elems[0];
+      const GuiElem& e = def.children()[0];
       const Font& fnt = *thm.font;
       def._w = fnt.glyphWidth(thm.checkCode) + (thm.border * 3) + e.layoutW();
       def._h = std::max(float(fnt.size() - 1 + (thm.border * 2)), e._h)
@@ -355,7 +458,7 @@ static void updateSize(GuiElem& def, const GuiTheme& thm)
     }
     case GUI_SUBMENU: {
       // menu header
-      const GuiElem& e = def.elems[0];
+      const GuiElem& e = def.children()[0];
       def._w = e.layoutW() + (thm.border * 3)
         + thm.font->glyphWidth(thm.subMenuCode);
       def._h = e.layoutH() + (thm.border * 2);
@@ -363,15 +466,15 @@ static void updateSize(GuiElem& def, const GuiTheme& thm)
     }
     case GUI_LISTSELECT: {
       // base size on 1st list item (all items should be same size)
-      GuiElem& e1 = def.elems[1]; // GUI_POPUP
-      const GuiElem* item = findItem(e1.elems[0], 0);
+      GuiElem& e1 = def.children()[1]; // GUI_POPUP
+      const GuiElem* item = findItem(e1.children()[0], 0);
       GX_ASSERT(item != nullptr);
       def._w = item->layoutW();
       def._h = item->layoutH();
       break;
     }
     case GUI_LISTSELECT_ITEM: {
-      const GuiElem& e = def.elems[0];
+      const GuiElem& e = def.children()[0];
       def._w = e.layoutW() + (thm.border * 3)
         + std::max(thm.font->glyphWidth(thm.listSelectCode),
                    thm.font->glyphWidth(thm.listSelectOpenCode));
@@ -394,6 +497,23 @@ static void updateSize(GuiElem& def, const GuiTheme& thm)
         + thm.entryTopMargin + thm.entryBottomMargin;
       break;
     }
+    case GUI_LIST: {
+      const auto& list = def.list();
+      const float b2 = thm.border * 2;
+      def._w = (list.size * thm.font->glyphWidth('A')) + b2
+        + thm.listScrollbarWidth;
+      def._h = (float(list.visibleRows) * listRowHeight(thm)) + b2;
+      break;
+    }
+    case GUI_TEXTEDIT: {
+      const auto& te = def.textEdit();
+      def._w = (te.size * thm.font->glyphWidth('A'))
+        + float(thm.entryLeftMargin + thm.entryRightMargin
+                + thm.listScrollbarWidth);
+      def._h = (float(te.visibleLines) * listRowHeight(thm))
+        + thm.entryTopMargin + thm.entryBottomMargin;
+      break;
+    }
     case GUI_IMAGE: {
       const float b2 = thm.border * 2;
       const auto& image = def.image();
@@ -402,17 +522,27 @@ static void updateSize(GuiElem& def, const GuiTheme& thm)
       break;
     }
     default:
-      if (def.elems.empty()) {
+      if (def.children().empty()) {
         def._w = thm.emptyWidth;
         def._h = thm.emptyHeight;
       } else {
-        const GuiElem& e = def.elems[0];
+        const GuiElem& e = def.children()[0];
         const float b2 = borderVal(thm, def.type) * 2;
         def._w = e.layoutW() + b2;
         def._h = e.layoutH() + b2;
       }
       break;
   }
+
+  def._nw = def._w;
+  def._nh = def._h;
+}
+
+static void updateSize(GuiElem& def, const GuiTheme& thm)
+{
+  // calculate child sizes before parent
+  for (GuiElem& e : def.children()) { updateSize(e, thm); }
+  calcSize(def, thm);
 }
 
 static void updatePos(GuiElem& def, const GuiTheme& thm,
@@ -446,8 +576,8 @@ static void updatePos(GuiElem& def, const GuiTheme& thm,
     case GUI_HFRAME: {
       const float fs = thm.frameSpacing;
       float total_w = 0;
-      for (const GuiElem& e : def.elems) { total_w += e.layoutW() + fs; }
-      for (GuiElem& e : def.elems) {
+      for (const GuiElem& e : def.children()) { total_w += e.layoutW() + fs; }
+      for (GuiElem& e : def.children()) {
         total_w -= e.layoutW() + fs;
         updatePos(e, thm, left, top, right - total_w, bottom);
         left = e._x + e._w + e.r_margin + fs;
@@ -457,8 +587,8 @@ static void updatePos(GuiElem& def, const GuiTheme& thm,
     case GUI_VFRAME: {
       const float fs = thm.frameSpacing;
       float total_h = 0;
-      for (const GuiElem& e : def.elems) { total_h += e.layoutH() + fs; }
-      for (GuiElem& e : def.elems) {
+      for (const GuiElem& e : def.children()) { total_h += e.layoutH() + fs; }
+      for (GuiElem& e : def.children()) {
         total_h -= e.layoutH() + fs;
         updatePos(e, thm, left, top, right, bottom - total_h);
         top = e._y + e._h + e.b_margin + fs;
@@ -467,39 +597,42 @@ static void updatePos(GuiElem& def, const GuiTheme& thm,
     }
     case GUI_CHECKBOX:
       left += thm.font->glyphWidth(thm.checkCode) + (thm.border * 3);
-      updatePos(def.elems[0], thm, left, top, right, bottom);
+      updatePos(def.children()[0], thm, left, top, right, bottom);
       break;
     case GUI_MENU: {
-      GuiElem& e0 = def.elems[0];
+      GuiElem& e0 = def.children()[0];
       updatePos(e0, thm, left, top, right, bottom);
       // always position menu frame below menu button for now
       top = e0._y + e0.layoutH() + thm.border;
-      GuiElem& e1 = def.elems[1];
+      GuiElem& e1 = def.children()[1];
       updatePos(e1, thm, left, top, left + e1.layoutW(), top + e1.layoutH());
       break;
     }
     case GUI_SUBMENU: {
       const float b = thm.border;
-      updatePos(def.elems[0], thm, left + b, top + b, right - b, bottom - b);
+      updatePos(def.children()[0], thm, left + b, top + b,
+                right - b, bottom - b);
       // sub-menu items
       left += def.layoutW();
-      GuiElem& e1 = def.elems[1];
+      GuiElem& e1 = def.children()[1];
       updatePos(e1, thm, left, top, left + e1.layoutW(), top + e1.layoutH());
       break;
     }
     case GUI_LISTSELECT: {
       const float b = thm.border;
-      updatePos(def.elems[0], thm, left + b, top + b, right - b, bottom - b);
-      updatePos(def.elems[1], thm, left - thm.popupBorder, bottom,
+      updatePos(def.children()[0], thm, left + b, top + b,
+                right - b, bottom - b);
+      updatePos(def.children()[1], thm, left - thm.popupBorder, bottom,
                 right, bottom);
       break;
     }
     default:
-      if (!def.elems.empty()) {
+      if (!def.children().empty()) {
         // align single child element
-        GX_ASSERT(def.elems.size() == 1);
+        GX_ASSERT(def.children().size() == 1);
         const float b = borderVal(thm, def.type);
-        updatePos(def.elems[0], thm, left + b, top + b, right - b, bottom - b);
+        updatePos(def.children()[0], thm, left + b, top + b,
+                  right - b, bottom - b);
       }
       break;
   }
@@ -527,13 +660,20 @@ void Gui::clear()
   _popupType = GUI_NULL;
   _event = {};
   _event2 = {};
+  _elemIndex.clear();
+  _eventIndex.clear();
   _needRender = true;
   _textChanged = false;
+  _textCache.clear();
 }
 
 void Gui::deletePanel(PanelID id)
 {
-  _needRender |= (removePanel(id) != nullptr);
+  if (removePanel(id) != nullptr) {
+    // panel theme fonts may be destroyed after panel is removed
+    _textCache.clear();
+    _needRender = true;
+  }
 }
 
 void Gui::raisePanel(PanelID id)
@@ -564,29 +704,51 @@ bool Gui::getPanelLayout(PanelID id, Rect& layout) const
   return true;
 }
 
+bool Gui::getElemLayout(PanelID pid, EventID eid, Rect& layout) const
+{
+  const auto [pPtr,ePtr] = findEvent(pid, eid);
+  if (!ePtr) { return false; }
+
+  layout = {pPtr->layout.x + ePtr->_x, pPtr->layout.y + ePtr->_y,
+            ePtr->_w, ePtr->_h};
+  return true;
+}
+
 bool Gui::update(Window& win, EventState& es)
+{
+  const auto [width,height] = win.dimensions();
+  return doUpdate(&win, es, win.eventState().events, width, height);
+}
+
+bool Gui::doUpdate(
+  Window* win, EventState& es, int allEvents, int width, int height)
 {
   // make saved event active
   _event = _event2;
   _event2 = {};
   _needRedraw = false;
 
+  int64_t layoutStart = 0;
   for (auto& p : _panels) {
     // size & position update
-    if (p->needLayout) {
-      updateSize(p->root, *p->theme);
-      updatePos(p->root, *p->theme, 0, 0, p->layout.w, p->layout.h);
-      p->needLayout = false;
+    if (!p->layoutElems.empty()) {
+      if (layoutStart == 0) { layoutStart = nsecTime(); }
+      for (GuiElem* e : p->layoutElems) { updateLayout(*p, *e); }
+      p->layoutElems.clear();
     }
   }
 
+  if (layoutStart != 0) {
+    _stats.layoutNsec += nsecTime() - layoutStart;
+    ++_stats.layouts;
+  }
+
   const int64_t now = es.lastPollTime;
 
   // mouse movement/button handling
   if (es.focused) {
-    const int allEvents = win.eventState().events;
-    if (allEvents & (EVENT_MOUSE_MOVE | EVENT_INPUT)) {
-      processMouseEvent(win, es);
+    if (allEvents & (EVENT_MOUSE_MOVE | EVENT_MOUSE_SCROLL | EVENT_INPUT)) {
+      processMouseEvent(win, es, allEvents, width, height);
     }
 
     if (!_event && _heldID != 0 && _repeatDelay >= 0
@@ -613,7 +775,7 @@ bool Gui::update(Window& win, EventState& es)
         _lastCursorUpdate += blinks * _cursorBlinkTime;
         if (blinks & 1) {
           _cursorState = !_cursorState;
-          _needRender = true;
+          setNeedRender(_focusID);
         }
       }
     }
@@ -621,15 +783,24 @@ bool Gui::update(Window& win, EventState& es)
 
   // redraw GUI if needed
   if (_needRender) {
-    _data.clear();
+    const int64_t renderStart = nsecTime();
     DrawList tmp;
-    DrawContext2D dc{_data}, dc2{tmp};
-    if (_bgColor != 0) { dc.clearView(_bgColor); }
     _needRender = false;
 
-    for (auto it = _panels.rbegin(), end = _panels.rend(); it != end; ++it) {
-      Panel& p = **it;
-      _needRender |= drawElem(p, p.root, dc, dc2, &(p.theme->panel));
+    // only panels marked for render are redrawn, others use their cached
+    // drawList from the last update
+    for (auto& pPtr : _panels) {
+      Panel& p = *pPtr;
+      if (!p.needRender) { continue; }
+
+      p.dl.clear();
+      DrawContext2D dc{p.dl}, dc2{tmp};
+      dc.shapeCache(&_shapeCache);
+      dc2.shapeCache(&_shapeCache);
+      dc.textCache(&_textCache);
+      dc2.textCache(&_textCache);
+      p.needRender = drawElem(p, p.root, dc, dc2, &(p.theme->panel));
+      _needRender |= p.needRender;
 
       if (!tmp.empty()) {
         dc.append(tmp);
@@ -637,6 +808,18 @@ bool Gui::update(Window& win, EventState& es)
       }
     }
 
+    _data.clear();
+    DrawContext2D dc{_data}, dc2{tmp};
+    dc.shapeCache(&_shapeCache);
+    dc2.shapeCache(&_shapeCache);
+    dc.textCache(&_textCache);
+    dc2.textCache(&_textCache);
+    if (_bgColor != 0) { dc.clearView(_bgColor); }
+    for (auto it = _panels.rbegin(), end = _panels.rend(); it != end; ++it) {
+      dc.append((*it)->dl);
+    }
+
+    // popups are drawn over all panels & aren't cached
     if (_popupID != 0) {
       for (auto it = _panels.rbegin(), end = _panels.rend(); it != end; ++it) {
         Panel& p = **it;
@@ -649,14 +832,42 @@ bool Gui::update(Window& win, EventState& es)
       }
     }
     _needRedraw = true;
+    _stats.renderNsec += nsecTime() - renderStart;
+    ++_stats.renders;
   }
 
   return _needRedraw;
 }
 
+int64_t Gui::nextDeadline() const
+{
+  // pending event, redraw or layout update needs immediate update
+  if (_event2 || _needRender) { return 0; }
+  for (auto& p : _panels) {
+    if (!p->layoutElems.empty()) { return 0; }
+  }
+
+  int64_t t = -1;
+  const auto setDeadline = [&t](int64_t x) {
+    if (t < 0 || x < t) { t = x; } };
+
+  if (_heldID != 0 && _repeatDelay >= 0) {
+    setDeadline(_heldTime + _repeatDelay + 1);
+  }
+
+  if (_focusID != 0 && _focusCursorPos == _focusRangeStart
+      && _cursorBlinkTime > 0) {
+    setDeadline(_lastCursorUpdate + _cursorBlinkTime);
+  }
+
+  return t;
+}
+
 void Gui::deactivatePopups()
 {
-  for (auto& p : _panels) { deactivate(p->root); }
+  for (auto& p : _panels) {
+    if (deactivate(p->root)) { setNeedRender(*p); }
+  }
   _popupID = 0;
   _popupType = GUI_NULL;
   _needRender = true;
@@ -665,14 +876,103 @@ void Gui::deactivatePopups()
 void Gui::activatePopup(Panel& p, const GuiElem& def)
 {
   if (_popupID != 0) { deactivatePopups(); }
-  _needRender |= activate(p.root, def._id);
+  if (activate(p.root, def._id)) { setNeedRender(p); }
   _popupID = def._id;
   _popupType = getPopupType(def.type);
 }
 
-void Gui::processMouseEvent(Window& win, EventState& es)
+void Gui::updateHitGrid(Panel& p)
+{
+  constexpr float CELL_SIZE = 32.0f;
+  constexpr int MAX_CELLS = 4096;
+
+  HitGrid& g = p.hit;
+  g.elems.clear();
+  addHitElems(p.root, g.elems);
+
+  const GuiElem& r = p.root;
+  g.x = r._x;
+  g.y = r._y;
+  g.cellSize = CELL_SIZE;
+  for (;;) {
+    g.cols = std::max(int(std::ceil(r._w / g.cellSize)), 1);
+    g.rows = std::max(int(std::ceil(r._h / g.cellSize)), 1);
+    if ((g.cols * g.rows) <= MAX_CELLS) { break; }
+    g.cellSize *= 2.0f;
+  }
+
+  const auto cellRange = [&g](const GuiElem& e, int& c0, int& r0,
+                              int& c1, int& r1) {
+    const float maxC = float(g.cols - 1), maxR = float(g.rows - 1);
+    c0 = int(std::clamp((e._x - g.x) / g.cellSize, 0.0f, maxC));
+    r0 = int(std::clamp((e._y - g.y) / g.cellSize, 0.0f, maxR));
+    c1 = int(std::clamp((e._x + e._w - g.x) / g.cellSize, 0.0f, maxC));
+    r1 = int(std::clamp((e._y + e._h - g.y) / g.cellSize, 0.0f, maxR));
+  };
+
+  // count elements per cell, then fill cell ranges in element order
+  // (cellStart[c] is used as the fill position & shifted back after)
+  g.cellStart.assign(std::size_t(g.cols * g.rows) + 1, 0);
+  for (const GuiElem* e : g.elems) {
+    if (e->_w <= 0 || e->_h <= 0) { continue; }
+    int c0, r0, c1, r1;
+    cellRange(*e, c0, r0, c1, r1);
+    for (int y = r0; y <= r1; ++y) {
+      for (int x = c0; x <= c1; ++x) { ++g.cellStart[(y * g.cols) + x + 1]; }
+    }
+  }
+
+  for (std::size_t i = 1; i < g.cellStart.size(); ++i) {
+    g.cellStart[i] += g.cellStart[i-1];
+  }
+
+  g.cellElems.resize(g.cellStart.back());
+  for (uint32_t i = 0; i < uint32_t(g.elems.size()); ++i) {
+    const GuiElem& e = *g.elems[i];
+    if (e._w <= 0 || e._h <= 0) { continue; }
+    int c0, r0, c1, r1;
+    cellRange(e, c0, r0, c1, r1);
+    for (int y = r0; y <= r1; ++y) {
+      for (int x = c0; x <= c1; ++x) {
+        g.cellElems[g.cellStart[(y * g.cols) + x]++] = i;
+      }
+    }
+  }
+
+  for (std::size_t i = g.cellStart.size() - 1; i > 0; --i) {
+    g.cellStart[i] = g.cellStart[i-1];
+  }
+  g.cellStart[0] = 0;
+  g.valid = true;
+}
+
+GuiElem* Gui::findHitElem(Panel& p, float x, float y)
+{
+  // popup elements aren't in grid
+  if (_popupType != GUI_NULL) {
+    return findElemByXY(p.root, x, y, _popupType);
+  }
+
+  HitGrid& g = p.hit;
+  if (!g.valid) { updateHitGrid(p); }
+
+  // elements outside the grid are in the edge cells
+  const int cx = int(std::clamp(
+    (x - g.x) / g.cellSize, 0.0f, float(g.cols - 1)));
+  const int cy = int(std::clamp(
+    (y - g.y) / g.cellSize, 0.0f, float(g.rows - 1)));
+  const int cell = (cy * g.cols) + cx;
+  for (uint32_t i = g.cellStart[cell]; i < g.cellStart[cell+1]; ++i) {
+    GuiElem* e = g.elems[g.cellElems[i]];
+    if (e->contains(x, y)) { return e; }
+  }
+
+  return p.root.contains(x, y) ? &p.root : nullptr;
+}
+
+void Gui::processMouseEvent(
+  Window* win, EventState& es, int allEvents, int width, int height)
 {
-  const int allEvents = win.eventState().events;
   const int64_t now = es.lastPollTime;
 
   const InputState* b1 = es.getInputState(BUTTON_1);
@@ -698,7 +998,7 @@ void Gui::processMouseEvent(Window& win, EventState& es)
   if (es.mouseIn) {
     for (auto& p : _panels) {
       const Vec2 pt = es.mousePt - Vec2{p->layout.x, p->layout.y};
-      if (!(ePtr = findElemByXY(p->root, pt.x, pt.y, _popupType))) { continue; }
+      if (!(ePtr = findHitElem(*p, pt.x, pt.y))) { continue; }
 
       es.removeButtonEvents();
       if (ePtr->_enabled) {
@@ -715,8 +1015,9 @@ void Gui::processMouseEvent(Window& win, EventState& es)
     const ElemID hid =
       (!lbuttonDown || isItemType(type) || id == _heldID) ? id : 0;
     if (_hoverID != hid) {
+      setNeedRender(_hoverID);
+      setNeedRender(hid);
       _hoverID = hid;
-      _needRender = true;
     }
   }
 
@@ -730,7 +1031,8 @@ void Gui::processMouseEvent(Window& win, EventState& es)
   }
   if (moveEvent) { _clickCount = 0; }
 
-  if (lbuttonDown && anyButtonPressEvent && type != GUI_ENTRY) {
+  if (lbuttonDown && anyButtonPressEvent && type != GUI_ENTRY
+      && type != GUI_TEXTEDIT) {
     setFocus(nullptr, now);
   }
 
@@ -747,13 +1049,12 @@ void Gui::processMouseEvent(Window& win, EventState& es)
         type = _heldType;
       }
 
-      const auto [width,height] = win.dimensions();
       const float mx = std::clamp(es.mousePt.x, 0.0f, float(width));
       const float my = std::clamp(es.mousePt.y, 0.0f, float(height));
       pPtr->layout.x += mx - _heldPt.x;
       pPtr->layout.y += my - _heldPt.y;
       _heldPt.set(mx, my);
-      _needRender = true;
+      setNeedRender(*pPtr);
     }
   } else if (type == GUI_ENTRY) {
     shape = MouseShape::ibeam;
@@ -788,9 +1089,86 @@ void Gui::processMouseEvent(Window& win, EventState& es)
         tf.fitText(entry.text, es.mousePt.x - entry.tx + 1));
       if (newPos != _focusCursorPos) {
         _focusCursorPos = newPos;
-        _needRender = true;
+        setNeedRender(*pPtr);
       }
     }
+  } else if (type == GUI_TEXTEDIT) {
+    auto& te = ePtr->textEdit();
+    const TextBuffer& tb = te.text;
+    const GuiTheme& thm = *(pPtr->theme);
+    const Rect area = textEditArea(*ePtr, thm);
+    const float mx = es.mousePt.x - pPtr->layout.x - area.x;
+    const float my = es.mousePt.y - pPtr->layout.y - area.y;
+    const float maxScroll = textEditMaxScroll(*ePtr, thm);
+    float scroll = te.scroll;
+    if (es.mouseScroll()) {
+      scroll -= es.scrollPt.y * listRowHeight(thm) * float(thm.listScrollRows);
+      es.removeEvent(EVENT_MOUSE_SCROLL);
+    }
+
+    // scrollbar hit check uses initial press point while held
+    const float sbx = ePtr->_x + ePtr->_w - thm.entryRightMargin
+      - thm.listScrollbarWidth;
+    const float px = (lpressEvent ? es.mousePt.x : _heldPt.x) - pPtr->layout.x;
+    if (lbuttonDown && px >= sbx && (lpressEvent || _heldID == id)) {
+      // scrollbar click/drag (center thumb on mouse)
+      const float th = textEditThumbHeight(*ePtr, thm);
+      if (area.h > th) {
+        scroll = ((my - (th * .5f)) / (area.h - th)) * maxScroll;
+      }
+    } else {
+      shape = MouseShape::ibeam;
+      if (lpressEvent) {
+        // update focus
+        setFocus(ePtr, now);
+        _cursorBlinkTime = thm.cursorBlinkTime;
+        const std::size_t pos =
+          textEditPos(*ePtr, thm, mx - _focusEntryOffset, my, _listText);
+        if (_clickCount == 3) {
+          // triple click - select line
+          const std::size_t line = tb.lineOf(pos);
+          _focusRangeStart = tb.lineStart(line);
+          _focusCursorPos = tb.lineEnd(line);
+        } else {
+          _focusCursorPos = _focusRangeStart = pos;
+          if (_clickCount == 2) {
+            // double click - select word (scan a piece at a time)
+            constexpr std::string_view space = " \n";
+            std::size_t& rs = _focusRangeStart;
+            std::size_t& cp = _focusCursorPos;
+            for (;;) {
+              const std::string_view sv = tb.chunkBefore(rs);
+              const std::size_t x = sv.find_last_of(space);
+              if (x != std::string_view::npos) { rs -= sv.size() - x - 1; }
+              else { rs -= sv.size(); }
+              if (sv.empty() || x != std::string_view::npos) { break; }
+            }
+            for (;;) {
+              const std::string_view sv = tb.chunkAt(cp);
+              const std::size_t x = sv.find_first_of(space);
+              if (x != std::string_view::npos) { cp += x; break; }
+              cp += sv.size();
+              if (sv.empty()) { break; }
+            }
+          }
+        }
+        setNeedRender(*pPtr);
+      } else if (lbuttonDown && moveEvent && _heldID == id) {
+        // select text w/ mouse
+        const std::size_t pos =
+          textEditPos(*ePtr, thm, mx - _focusEntryOffset, my, _listText);
+        if (pos != _focusCursorPos) {
+          _focusCursorPos = pos;
+          setNeedRender(*pPtr);
+        }
+      }
+    }
+
+    scroll = std::clamp(scroll, 0.0f, maxScroll);
+    if (scroll != te.scroll) {
+      te.scroll = scroll;
+      setNeedRender(*pPtr);
+    }
   } else if (hasPopup(type)) {
     const bool pressEvent = lpressEvent || (type == GUI_MENU && rpressEvent);
     if (pressEvent && ePtr->_active) {
@@ -819,18 +1197,59 @@ void Gui::processMouseEvent(Window& win, EventState& es)
         GuiElem& ls = *parent;
         GX_ASSERT(ls.type == GUI_LISTSELECT);
         ls.item().no = item_no;
-        GuiElem& e0 = ls.elems[0];
-        const GuiElem& src = ePtr->elems[0];
+        GuiElem& e0 = ls.children()[0];
+        const GuiElem& src = ePtr->children()[0];
         e0.label().text = src.label().text;
         e0.eid  = src.eid;
         const GuiTheme& thm = *(pPtr->theme);
         const float b = thm.border;
         updatePos(e0, thm, ls._x + b, ls._y + b, ls._x + ls._w - b,
                   ls._y + ls._h - b);
+        setNeedRender(*pPtr);
         addEvent(*pPtr, ls, item_no, now);
         deactivatePopups();
       }
     }
+  } else if (type == GUI_LIST) {
+    auto& list = ePtr->list();
+    const GuiTheme& thm = *(pPtr->theme);
+    const Rect area = listArea(*ePtr, thm);
+    const float mx = es.mousePt.x - pPtr->layout.x - area.x;
+    const float my = es.mousePt.y - pPtr->layout.y - area.y;
+    const float rh = listRowHeight(thm);
+    const float maxScroll = listMaxScroll(*ePtr, thm);
+    float scroll = list.scroll;
+    if (es.mouseScroll()) {
+      scroll -= es.scrollPt.y * rh * float(thm.listScrollRows);
+      es.removeEvent(EVENT_MOUSE_SCROLL);
+    }
+
+    // scrollbar hit check uses initial press point while held
+    const float px = (lpressEvent ? es.mousePt.x : _heldPt.x)
+      - pPtr->layout.x - area.x;
+    if (lbuttonDown && px >= area.w && (lpressEvent || _heldID == id)) {
+      // scrollbar click/drag (center thumb on mouse)
+      const float th = listThumbHeight(*ePtr, thm);
+      if (area.h > th) {
+        scroll = ((my - (th * .5f)) / (area.h - th)) * maxScroll;
+      }
+    } else if (lpressEvent && mx >= 0 && my >= 0 && my < area.h) {
+      // row select
+      const int row = int((my + list.scroll) / rh);
+      if (row < list.rows) {
+        if (list.selected != row) {
+          list.selected = row;
+          setNeedRender(*pPtr);
+        }
+        addEvent(*pPtr, *ePtr, row, now);
+      }
+    }
+
+    scroll = std::clamp(scroll, 0.0f, maxScroll);
+    if (scroll != list.scroll) {
+      list.scroll = scroll;
+      setNeedRender(*pPtr);
+    }
   } else if (type == GUI_BUTTON_PRESS) {
     if (lpressEvent) {
       _repeatDelay = ePtr->button().repeatDelay;
@@ -850,21 +1269,22 @@ void Gui::processMouseEvent(Window& win, EventState& es)
   }
 
   // update cursor gfx
-  if (shape != win.mouseShape()) {
-    win.setMouseShape(shape);
+  if (win && shape != win->mouseShape()) {
+    win->setMouseShape(shape);
   }
 
   // held state update
   if (lpressEvent && id != 0) {
+    setNeedRender(_heldID);
     _heldID = id;
     _heldType = type;
     _heldTime = now;
     _heldPt = es.mousePt;
-    _needRender = true;
+    setNeedRender(*pPtr);
   } else if ((_heldType == GUI_BUTTON_PRESS && _heldID != id)
              || (!lbuttonDown && _heldID != 0)) {
+    setNeedRender(_heldID);
     clearHeld();
-    _needRender = true;
   }
 
   // popup cleanup
@@ -879,11 +1299,17 @@ void Gui::processTextEvent(EventState& es)
   if (!elemP) { return; }
 
   GuiElem& e = *elemP;
+  if (e.type == GUI_TEXTEDIT) {
+    processTextEditEvent(es, *panelP, e);
+    return;
+  }
+
   GX_ASSERT(e.type == GUI_ENTRY);
   auto& entry = e.entry();
 
   const int64_t now = es.lastPollTime;
   bool usedEvent = false;
+  bool changed = false;
 
   if (!es.text.empty()) {
     usedEvent = true;
@@ -901,7 +1327,7 @@ void Gui::processTextEvent(EventState& es)
       if (rangeLen > 0) {
         eraseUTF8(entry.text, rangeStart, rangeLen);
         _focusCursorPos = _focusRangeStart = rangeStart;
-        _needRender = _textChanged = true;
+        changed = _textChanged = true;
       } else if (_focusCursorPos > 0) {
         GX_ASSERT(!entry.text.empty());
         if (es.mods == MODIFIER_CTRL) {
@@ -911,21 +1337,21 @@ void Gui::processTextEvent(EventState& es)
           eraseUTF8(entry.text, --_focusCursorPos, 1);
         }
         _focusRangeStart = _focusCursorPos;
-        _needRender = _textChanged = true;
+        changed = _textChanged = true;
       }
     } else if (ks.val == KEY_DELETE) {
       usedEvent = true;
       if (rangeLen > 0) {
         eraseUTF8(entry.text, rangeStart, rangeLen);
         _focusCursorPos = _focusRangeStart = rangeStart;
-        _needRender = _textChanged = true;
+        changed = _textChanged = true;
       } else if (_focusCursorPos < lengthUTF8(entry.text)) {
         if (es.mods == MODIFIER_CTRL) {
           eraseUTF8(entry.text, _focusCursorPos, std::string::npos);
         } else {
           eraseUTF8(entry.text, _focusCursorPos, 1);
         }
-        _needRender = _textChanged = true;
+        changed = _textChanged = true;
       }
     } else if (ks.val == KEY_V && es.mods == MODIFIER_CTRL) {
       // (CTRL-V) paste first line of clipboard
@@ -946,13 +1372,13 @@ void Gui::processTextEvent(EventState& es)
         setClipboard(cp);
         eraseUTF8(entry.text, rangeStart, rangeLen);
         _focusCursorPos = _focusRangeStart = rangeStart;
-        _needRender = _textChanged = true;
+        changed = _textChanged = true;
       }
     } else if (ks.val == KEY_A && es.mods == MODIFIER_CTRL) {
       // (CTRL-A) select all text
       _focusRangeStart = 0;
       _focusCursorPos = lengthUTF8(entry.text);
-      _needRender = true;
+      changed = true;
     } else if ((ks.val == KEY_TAB && es.mods == 0) || ks.val == KEY_ENTER) {
       usedEvent = true;
       setFocus(findNextElem(panelP->root, e.eid, GUI_ENTRY), now);
@@ -966,14 +1392,14 @@ void Gui::processTextEvent(EventState& es)
       if (es.mods == 0) {
         if (rangeLen > 0) {
           _focusCursorPos = _focusRangeStart = rangeStart;
-          _needRender = true;
+          changed = true;
         } else if (_focusCursorPos > 0) {
           _focusRangeStart = --_focusCursorPos;
-          _needRender = true;
+          changed = true;
         }
       } else if (es.mods == MODIFIER_SHIFT) {
         if (_focusCursorPos > 0) {
-          --_focusCursorPos; _needRender = true;
+          --_focusCursorPos; changed = true;
         }
       }
     } else if (ks.val == KEY_RIGHT) {
@@ -981,25 +1407,25 @@ void Gui::processTextEvent(EventState& es)
       if (es.mods == 0) {
         if (rangeLen > 0) {
           _focusCursorPos = _focusRangeStart = rangeEnd;
-          _needRender = true;
+          changed = true;
         } else if (_focusCursorPos < lengthUTF8(entry.text)) {
           _focusRangeStart = ++_focusCursorPos;
-          _needRender = true;
+          changed = true;
         }
       } else if (es.mods == MODIFIER_SHIFT) {
         if (_focusCursorPos < lengthUTF8(entry.text)) {
-          ++_focusCursorPos; _needRender = true;
+          ++_focusCursorPos; changed = true;
         }
       }
     } else if (ks.val == KEY_HOME) {
       usedEvent = true;
       if (es.mods == 0) {
         if (_focusCursorPos > 0 || rangeLen > 0) {
-          _focusCursorPos = _focusRangeStart = 0; _needRender = true;
+          _focusCursorPos = _focusRangeStart = 0; changed = true;
         }
       } else if (es.mods == MODIFIER_SHIFT) {
         if (_focusCursorPos > 0) {
-          _focusCursorPos = 0; _needRender = true;
+          _focusCursorPos = 0; changed = true;
         }
       }
     } else if (ks.val == KEY_END) {
@@ -1007,11 +1433,11 @@ void Gui::processTextEvent(EventState& es)
       const std::size_t ts = lengthUTF8(entry.text);
       if (es.mods == 0) {
         if (_focusCursorPos < ts || rangeLen > 0) {
-          _focusCursorPos = _focusRangeStart = ts; _needRender = true;
+          _focusCursorPos = _focusRangeStart = ts; changed = true;
         }
       } else if (es.mods == MODIFIER_SHIFT) {
         if (_focusCursorPos < ts) {
-          _focusCursorPos = ts; _needRender = true;
+          _focusCursorPos = ts; changed = true;
         }
       }
     }
@@ -1022,11 +1448,170 @@ void Gui::processTextEvent(EventState& es)
     es.removeKeyEvents();
     if (_focusCursorPos == _focusRangeStart) {
       // reset cursor blink state
-      _needRender |= !_cursorState;
+      changed |= !_cursorState;
       _lastCursorUpdate = now;
       _cursorState = true;
     }
   }
+
+  if (changed) { setNeedRender(*panelP); }
+}
+
+void Gui::processTextEditEvent(EventState& es, Panel& p, GuiElem& e)
+{
+  auto& te = e.textEdit();
+  TextBuffer& tb = te.text;
+  const int64_t now = es.lastPollTime;
+  bool usedEvent = false;
+  bool changed = false;
+
+  const auto eraseRange = [&]() {
+    const std::size_t rangeStart = std::min(_focusCursorPos, _focusRangeStart);
+    const std::size_t rangeEnd = std::max(_focusCursorPos, _focusRangeStart);
+    if (rangeStart == rangeEnd) { return false; }
+    tb.erase(rangeStart, rangeEnd - rangeStart);
+    _focusCursorPos = _focusRangeStart = rangeStart;
+    _textChanged = true;
+    return true;
+  };
+
+  const auto insertText = [&](std::string_view text) {
+    eraseRange();
+    tb.insert(_focusCursorPos, text);
+    _focusCursorPos = _focusRangeStart = _focusCursorPos + text.size();
+    _textChanged = true;
+  };
+
+  const auto linePos = [&](std::ptrdiff_t lines) {
+    // cursor position moved up/down by lines (keeps character column)
+    const std::size_t line = tb.lineOf(_focusCursorPos);
+    std::size_t col = 0;
+    for (std::size_t x = tb.lineStart(line); x < _focusCursorPos;
+         x = tb.nextChar(x)) { ++col; }
+
+    const std::size_t newLine = std::size_t(std::clamp(
+      std::ptrdiff_t(line) + lines, std::ptrdiff_t{0},
+      std::ptrdiff_t(tb.lines()) - 1));
+    std::size_t pos = tb.lineStart(newLine);
+    const std::size_t end = tb.lineEnd(newLine);
+    for (; col > 0 && pos < end; --col) { pos = tb.nextChar(pos); }
+    return pos;
+  };
+
+  if (!es.text.empty()) {
+    usedEvent = changed = true;
+    insertText(es.text);
+  }
+
+  for (const InputState& ks : es.inputStates) {
+    if (!ks.pressCount && !ks.repeatCount) { continue; }
+
+    const std::size_t rangeStart = std::min(_focusCursorPos, _focusRangeStart);
+    const std::size_t rangeEnd = std::max(_focusCursorPos, _focusRangeStart);
+    const bool shift = (es.mods & MODIFIER_SHIFT) != 0;
+    const bool ctrl = (es.mods & MODIFIER_CTRL) != 0;
+
+    // cursor movement (shift extends selected range)
+    std::size_t pos = _focusCursorPos;
+    bool move = true;
+    switch (ks.val) {
+      case KEY_LEFT:
+        pos = (rangeStart != rangeEnd && !shift)
+          ? rangeStart : tb.prevChar(pos);
+        break;
+      case KEY_RIGHT:
+        pos = (rangeStart != rangeEnd && !shift)
+          ? rangeEnd : tb.nextChar(pos);
+        break;
+      case KEY_UP:        pos = linePos(-1); break;
+      case KEY_DOWN:      pos = linePos(1); break;
+      case KEY_PAGE_UP:   pos = linePos(-te.visibleLines); break;
+      case KEY_PAGE_DOWN: pos = linePos(te.visibleLines); break;
+      case KEY_HOME:
+        pos = ctrl ? 0 : tb.lineStart(tb.lineOf(pos));
+        break;
+      case KEY_END:
+        pos = ctrl ? tb.size() : tb.lineEnd(tb.lineOf(pos));
+        break;
+      default:
+        move = false;
+        break;
+    }
+
+    if (move) {
+      usedEvent = changed = true;
+      _focusCursorPos = pos;
+      if (!shift) { _focusRangeStart = pos; }
+      continue;
+    }
+
+    if (ks.val == KEY_BACKSPACE) {
+      usedEvent = changed = true;
+      if (!eraseRange() && _focusCursorPos > 0) {
+        const std::size_t prev = tb.prevChar(_focusCursorPos);
+        tb.erase(prev, _focusCursorPos - prev);
+        _focusCursorPos = _focusRangeStart = prev;
+        _textChanged = true;
+      }
+    } else if (ks.val == KEY_DELETE) {
+      usedEvent = changed = true;
+      if (!eraseRange() && _focusCursorPos < tb.size()) {
+        const std::size_t next = tb.nextChar(_focusCursorPos);
+        tb.erase(_focusCursorPos, next - _focusCursorPos);
+        _textChanged = true;
+      }
+    } else if (ks.val == KEY_ENTER || ks.val == KEY_KP_ENTER) {
+      usedEvent = changed = true;
+      insertText("\n");
+    } else if (ks.val == KEY_TAB && es.mods == 0) {
+      usedEvent = changed = true;
+      insertText("  ");
+    } else if (ks.val == KEY_V && es.mods == MODIFIER_CTRL) {
+      // (CTRL-V) paste clipboard
+      usedEvent = changed = true;
+      insertText(getClipboardFull());
+    } else if ((ks.val == KEY_C || ks.val == KEY_X)
+               && es.mods == MODIFIER_CTRL) {
+      // (CTRL-C) copy/(CTRL-X) cut selected text
+      usedEvent = true;
+      if (rangeStart != rangeEnd) {
+        std::string cp;
+        tb.getText(rangeStart, rangeEnd - rangeStart, cp);
+        setClipboard(cp);
+        if (ks.val == KEY_X) { changed = eraseRange(); }
+      }
+    } else if (ks.val == KEY_A && es.mods == MODIFIER_CTRL) {
+      // (CTRL-A) select all text
+      usedEvent = changed = true;
+      _focusRangeStart = 0;
+      _focusCursorPos = tb.size();
+    }
+  }
+
+  if (usedEvent) {
+    es.removeTextEvent();
+    es.removeKeyEvents();
+    if (_focusCursorPos == _focusRangeStart) {
+      // reset cursor blink state
+      changed |= !_cursorState;
+      _lastCursorUpdate = now;
+      _cursorState = true;
+    }
+  }
+
+  if (changed) {
+    // scroll to keep cursor line in view
+    const GuiTheme& thm = *p.theme;
+    const float lh = listRowHeight(thm);
+    const float areaH = textEditArea(e, thm).h;
+    const float cy = float(tb.lineOf(_focusCursorPos)) * lh;
+    if (cy < te.scroll) {
+      te.scroll = cy;
+    } else if ((cy + lh) > (te.scroll + areaH)) {
+      te.scroll = cy + lh - areaH;
+    }
+    setNeedRender(p);
+  }
 }
 
 void Gui::addEntryText(GuiElem& e, std::string_view text)
@@ -1067,7 +1652,8 @@ void Gui::addEntryChar(GuiElem::EntryProps& entry, int32_t code)
 
     eraseUTF8(txt, rangeStart, rangeLen);
     _focusCursorPos = _focusRangeStart = rangeStart;
-    _needRender = _textChanged = true;
+    _textChanged = true;
+    setNeedRender(_focusID);
   }
 
   if (entry.maxChars != 0 && lengthUTF8(txt) >= entry.maxChars) {
@@ -1132,7 +1718,8 @@ void Gui::addEntryChar(GuiElem::EntryProps& entry, int32_t code)
 
   insertUTF8(txt, _focusCursorPos, code);
   _focusRangeStart = ++_focusCursorPos;
-  _needRender = _textChanged = true;
+  _textChanged = true;
+  setNeedRender(_focusID);
 }
 
 void Gui::setFocus(const GuiElem* e, int64_t now)
@@ -1148,21 +1735,25 @@ void Gui::setFocus(const GuiElem* e, int64_t now)
     _textChanged = false;
     const auto [panelP,elemP] = findElem(_focusID);
     if (elemP) {
-      auto& entry = elemP->entry();
-      if (entry.text.empty()) {
-        const EntryType t = entry.type;
-        if (t == ENTRY_CARDINAL || t == ENTRY_INTEGER || t == ENTRY_FLOAT) {
-          entry.text = "0";
+      if (elemP->type == GUI_ENTRY) {
+        auto& entry = elemP->entry();
+        if (entry.text.empty()) {
+          const EntryType t = entry.type;
+          if (t == ENTRY_CARDINAL || t == ENTRY_INTEGER || t == ENTRY_FLOAT) {
+            entry.text = "0";
+          }
         }
       }
       addEvent(*panelP, *elemP, 0, now);
     }
   }
 
+  setNeedRender(_focusID);
+  setNeedRender(id);
   _focusID = id;
-  _focusCursorPos = _focusRangeStart = e ? lengthUTF8(e->entry().text) : 0;
+  _focusCursorPos = _focusRangeStart =
+    (e && e->type == GUI_ENTRY) ? lengthUTF8(e->entry().text) : 0;
   _focusEntryOffset = 0;
-  _needRender = true;
 }
 
 void Gui::setElemState(PanelID pid, EventID eid, bool enable)
@@ -1170,48 +1761,55 @@ void Gui::setElemState(PanelID pid, EventID eid, bool enable)
   GuiElem* e = findEventElem(pid, eid);
   if (e && e->_enabled != enable) {
     e->_enabled = enable;
-    _needRender = true;
+    setNeedRender(e->_id);
   }
 }
 
 void Gui::setAllElemState(PanelID id, bool enable)
 {
-  int count = 0;
   for (auto& p : _panels) {
-    if (id == 0 || p->id == id) { count += allElemState(p->root, enable); }
+    if ((id == 0 || p->id == id) && allElemState(p->root, enable) > 0) {
+      setNeedRender(*p);
+    }
   }
-  _needRender |= (count > 0);
 }
 
 bool Gui::setText(PanelID pid, EventID eid, std::string_view text)
 {
-  for (auto& p : _panels) {
-    if (pid != 0 && pid != p->id) { continue; }
-    GuiElem* e = findByEventID(p->root, eid);
-    if (!e) { continue; }
-
-    switch (e->type) {
-      case GUI_ENTRY:
-        e->entry().text = text;
-        if (_focusID == e->_id) {
-          _focusCursorPos = _focusRangeStart = lengthUTF8(text);
-          _focusEntryOffset = 0;
-        }
-        break;
-      case GUI_LABEL:
-      case GUI_VLABEL:
-        e->label().text = text;
-        p->needLayout = true;
-        break;
+  const auto [panelP,e] = findEvent(pid, eid);
+  if (!e) { return false; }
 
-      default:
-        return false;
-    }
+  switch (e->type) {
+    case GUI_ENTRY:
+      e->entry().text = text;
+      if (_focusID == e->_id) {
+        _focusCursorPos = _focusRangeStart = lengthUTF8(text);
+        _focusEntryOffset = 0;
+      }
+      break;
+    case GUI_TEXTEDIT:
+      e->textEdit().text.assign(text);
+      e->textEdit().scroll = 0;
+      if (_focusID == e->_id) {
+        _focusCursorPos = _focusRangeStart = 0;
+        _focusEntryOffset = 0;
+      }
+      break;
+    case GUI_LABEL:
+    case GUI_VLABEL:
+      e->label().text = text;
+      if (!e->_needLayout) {
+        e->_needLayout = true;
+        panelP->layoutElems.push_back(e);
+      }
+      break;
 
-    _needRender = true;
-    return true;
+    default:
+      return false;
   }
-  return false;
+
+  setNeedRender(*panelP);
+  return true;
 }
 
 bool Gui::setBool(PanelID pid, EventID eid, bool val)
@@ -1220,22 +1818,46 @@ bool Gui::setBool(PanelID pid, EventID eid, bool val)
   if (!e || e->type != GUI_CHECKBOX) { return false; }
 
   e->checkbox().set = val;
-  _needRender = true;
+  setNeedRender(e->_id);
   return true;
 }
 
 bool Gui::setItemNo(PanelID pid, EventID eid, int no)
 {
   GuiElem* e = findEventElem(pid, eid);
-  if (!e || e->type != GUI_LISTSELECT) { return false; }
+  if (!e) { return false; }
 
-  e->item().no = no;
-  _needRender = true;
+  if (e->type == GUI_LISTSELECT) {
+    e->item().no = no;
+  } else if (e->type == GUI_LIST) {
+    e->list().selected = no;
+  } else {
+    return false;
+  }
+
+  setNeedRender(e->_id);
+  return true;
+}
+
+bool Gui::setListRows(PanelID pid, EventID eid, int rows)
+{
+  const auto [panelP,e] = findEvent(pid, eid);
+  if (!e || e->type != GUI_LIST) { return false; }
+
+  auto& list = e->list();
+  list.rows = rows;
+  if (list.selected >= rows) { list.selected = -1; }
+  // clamp scroll now (next update may handle a row click before redraw)
+  list.scroll = std::clamp(
+    list.scroll, 0.0f, listMaxScroll(*e, *panelP->theme));
+  setNeedRender(*panelP);
   return true;
 }
 
 PanelID Gui::addPanel(PanelPtr ptr, float x, float y, Align align)
 {
+  ptr->elems.reserve(countElems(ptr->root));
+  flattenElems(ptr->elems, ptr->root);
   initElem(ptr->root);
   layout(*ptr, x, y, align);
 
@@ -1248,6 +1870,7 @@ PanelID Gui::addPanel(PanelPtr ptr, float x, float y, Align align)
   }
 
   const auto itr = _panels.insert(_panels.begin(), std::move(ptr));
+  indexPanel(**itr);
   return (*itr)->id;
 }
 
@@ -1258,11 +1881,58 @@ void Gui::layout(Panel& p, float x, float y, Align align)
   p.layout = {x,y,0,0};
   if (hAlign(align) == Align::right) { std::swap(p.layout.x, p.layout.w); }
   if (vAlign(align) == Align::bottom) { std::swap(p.layout.y, p.layout.h); }
-  p.needLayout = false;
+  for (GuiElem* e : p.layoutElems) { e->_needLayout = false; }
+  p.layoutElems.clear();
+  p.hit.valid = false;
   p.root.align = align;
   updateSize(p.root, thm);
   updatePos(p.root, thm, 0, 0, p.layout.w, p.layout.h);
-  _needRender = true;
+  setNeedRender(p);
+}
+
+void Gui::updateLayout(Panel& p, GuiElem& def)
+{
+  // resize element & propagate size change to parent elements until
+  // an element's size is unchanged, then reposition that element's subtree
+  if (!def._needLayout) { return; }
+  def._needLayout = false;
+  p.hit.valid = false;
+
+  const GuiTheme& thm = *p.theme;
+  GuiElem* e = &def;
+  float nw = e->_nw, nh = e->_nh; // previous natural size
+  float w = e->_w, h = e->_h;     // previous size
+  updateSize(*e, thm);
+
+  while (e->_parent && (e->_nw != nw || e->_nh != nh)) {
+    GuiElem& parent = *e->_parent;
+    nw = parent._nw; nh = parent._nh;
+    w = parent._w; h = parent._h;
+
+    // restore natural child sizes before parent size calc
+    // (justified children are resized again by calcSize)
+    for (GuiElem& c : parent.children()) {
+      if (c._w != c._nw || c._h != c._nh) {
+        c._w = c._nw; c._h = c._nh;
+        resizedElem(thm, c);
+      }
+    }
+    calcSize(parent, thm);
+    e = &parent;
+  }
+
+  if (!e->_parent) {
+    // full panel update
+    updatePos(*e, thm, 0, 0, p.layout.w, p.layout.h);
+  } else {
+    // size unchanged - restore any justify resize & reposition in place
+    if (e->_w != w || e->_h != h) {
+      e->_w = w; e->_h = h;
+      resizedElem(thm, *e);
+    }
+    updatePos(*e, thm, e->_x - e->l_margin, e->_y - e->t_margin,
+              e->_x + e->_w + e->r_margin, e->_y + e->_h + e->b_margin);
+  }
 }
 
 void Gui::initElem(GuiElem& def)
@@ -1272,15 +1942,18 @@ void Gui::initElem(GuiElem& def)
     const GuiElem* e = findItem(def, def.item().no);
     if (!e && def.item().no != 0) { e = findItem(def, 0); }
     if (e) {
-      GuiElem& e0 = def.elems[0];
-      const GuiElem& src = e->elems[0];
+      GuiElem& e0 = def.children()[0];
+      const GuiElem& src = e->children()[0];
       e0.label().text = src.label().text;
       e0.align = Align::center_left;
       e0.eid   = src.eid;
       def.item().no = e->item().no;
     }
   }
-  for (GuiElem& e : def.elems) { initElem(e); }
+  for (GuiElem& e : def.children()) {
+    e._parent = &def;
+    initElem(e);
+  }
 }
 
 bool Gui::drawElem(
@@ -1347,12 +2020,16 @@ bool Gui::drawElem(
       }
       break;
     case GUI_ENTRY:
+    case GUI_TEXTEDIT:
       if (!def._enabled) {
         style = &thm.entryDisable;
       } else {
         style = (def._id == _focusID) ? &thm.entryFocus : &thm.entry;
       }
       break;
+    case GUI_LIST:
+      style = def._enabled ? &thm.list : &thm.listDisable;
+      break;
     default:
       GX_ASSERT(style != nullptr);
       break;
@@ -1495,6 +2172,137 @@ bool Gui::drawElem(
       }
       break;
     }
+    case GUI_LIST: {
+      dc.shape({ex, ey, ew, eh}, *style);
+      auto& list = def.list();
+      const float rh = listRowHeight(thm);
+      Rect area = listArea(def, thm);
+      area.x += p.layout.x;
+      area.y += p.layout.y;
+      const float areaBottom = area.y + area.h;
+      list.scroll = std::clamp(list.scroll, 0.0f, listMaxScroll(def, thm));
+
+      // only rows in view are drawn (partial rows are clipped)
+      const TextFormat tf{
+        .font = thm.font, .lineSpacing = float(thm.textSpacing)};
+      const int first = int(list.scroll / rh);
+      float y = area.y + (float(first) * rh) - list.scroll;
+      dc2.textClip(area);
+      for (int row = first; row < list.rows && y < areaBottom;
+           ++row, y += rh) {
+        const Style* rs = style;
+        if (row == list.selected) {
+          rs = &thm.listRowSelect;
+          const float y0 = std::max(y, area.y);
+          const float y1 = std::min(y + rh, areaBottom);
+          dc.color(rs->fillColor);
+          dc.rectangle({area.x, y0, area.w, y1 - y0});
+        }
+        _listText.clear();
+        if (list.rowText) { list.rowText(row, _listText); }
+        dc2.color(rs->textColor);
+        dc2.text(tf, {area.x, y}, Align::top_left, _listText);
+      }
+      dc2.clearTextClip();
+
+      const float maxScroll = listMaxScroll(def, thm);
+      if (maxScroll > 0) {
+        // scrollbar thumb
+        const float th = listThumbHeight(def, thm);
+        const float ty = area.y + ((area.h - th) * (list.scroll / maxScroll));
+        dc.color(thm.listScrollbar.fillColor);
+        dc.rectangle({area.x + area.w, ty, float(thm.listScrollbarWidth), th});
+      }
+      break;
+    }
+    case GUI_TEXTEDIT: {
+      dc.shape({ex, ey, ew, eh}, *style);
+      auto& te = def.textEdit();
+      const TextBuffer& tb = te.text;
+      const TextFormat tf{
+        .font = thm.font, .lineSpacing = float(thm.textSpacing)};
+      const float lh = listRowHeight(thm);
+      Rect area = textEditArea(def, thm);
+      area.x += p.layout.x;
+      area.y += p.layout.y;
+      const float areaBottom = area.y + area.h;
+      const float maxScroll = textEditMaxScroll(def, thm);
+      te.scroll = std::clamp(te.scroll, 0.0f, maxScroll);
+
+      // horizontal text offset to keep cursor in view
+      // (only cursor line is measured)
+      const bool focus = (def._id == _focusID);
+      const float cw = thm.cursorWidth;
+      float cx = 0;
+      if (focus) {
+        const std::size_t ls = tb.lineStart(tb.lineOf(_focusCursorPos));
+        tb.getText(ls, _focusCursorPos - ls, _listText);
+        cx = area.x + _focusEntryOffset + tf.calcProperties(_listText).width;
+        const float rightEdge = area.x + area.w - cw;
+        if (cx < area.x) {
+          _focusEntryOffset += area.x - cx; cx = area.x;
+        } else if (cx > rightEdge) {
+          _focusEntryOffset -= cx - rightEdge; cx = rightEdge;
+        }
+      }
+      const float tx = area.x + (focus ? _focusEntryOffset : 0.0f);
+      const std::size_t rangeStart =
+        focus ? std::min(_focusCursorPos, _focusRangeStart) : 0;
+      const std::size_t rangeEnd =
+        focus ? std::max(_focusCursorPos, _focusRangeStart) : 0;
+
+      // only lines in view are fetched & drawn (partial lines are clipped)
+      const std::size_t first = std::size_t(te.scroll / lh);
+      float y = area.y + (float(first) * lh) - te.scroll;
+      dc2.textClip(area);
+      dc2.color(style->textColor);
+      for (std::size_t line = first; line < tb.lines() && y < areaBottom;
+           ++line, y += lh) {
+        tb.getLine(line, _listText);
+        const std::size_t ls = tb.lineStart(line), le = tb.lineEnd(line);
+        if (rangeStart != rangeEnd && rangeStart <= le && rangeEnd > ls) {
+          // draw selected text background
+          const std::string_view txt = _listText;
+          const float sx0 = tx + tf.calcProperties(
+            txt.substr(0, std::max(rangeStart, ls) - ls)).width;
+          float sx1 = tx + tf.calcProperties(
+            txt.substr(0, std::min(rangeEnd, le) - ls)).width;
+          if (rangeEnd > le) { sx1 += cw; } // line end selected
+          const float x0 = std::max(sx0 - 1, area.x);
+          const float x1 = std::min(sx1 + 1, area.x + area.w);
+          const float y0 = std::max(y, area.y);
+          const float y1 = std::min(y + lh, areaBottom);
+          if (x1 > x0) {
+            dc.color(thm.textSelectColor);
+            dc.rectangle({x0, y0, x1 - x0, y1 - y0});
+          }
+        }
+        dc2.text(tf, {tx, y}, Align::top_left, _listText);
+      }
+      dc2.clearTextClip();
+
+      if (focus && rangeStart == rangeEnd && _cursorState) {
+        // draw cursor
+        const float cy = area.y - te.scroll - 1
+          + (float(tb.lineOf(_focusCursorPos)) * lh);
+        const float ch = float(thm.font->size());
+        const float y0 = std::max(cy, area.y - 1);
+        const float y1 = std::min(cy + ch, areaBottom);
+        if (y1 > y0) {
+          dc.color(thm.cursorColor);
+          dc.rectangle({cx - 1, y0, cw, y1 - y0});
+        }
+      }
+
+      if (maxScroll > 0) {
+        // scrollbar thumb
+        const float th = textEditThumbHeight(def, thm);
+        const float ty = area.y + ((area.h - th) * (te.scroll / maxScroll));
+        dc.color(thm.listScrollbar.fillColor);
+        dc.rectangle({area.x + area.w, ty, float(thm.listScrollbarWidth), th});
+      }
+      break;
+    }
     case GUI_IMAGE: {
       const auto& image = def.image();
       dc.texture(image.texId);
@@ -1511,7 +2319,7 @@ bool Gui::drawElem(
   }
 
   // draw child elements
-  for (GuiElem& e : def.elems) {
+  for (GuiElem& e : def.children()) {
     if (e.type != GUI_POPUP) {
       needRedraw |= drawElem(p, e, dc, dc2, style);
     }
@@ -1523,7 +2331,7 @@ bool Gui::drawPopup(
   Panel& p, GuiElem& def, DrawContext2D& dc, DrawContext2D& dc2)
 {
   bool needRedraw = false; // use for anim trigger later
-  for (GuiElem& e : def.elems) {
+  for (GuiElem& e : def.children()) {
     if (def._active && e.type == GUI_POPUP) {
       const GuiTheme& thm = *p.theme;
       needRedraw |= drawElem(
@@ -1535,31 +2343,52 @@ bool Gui::drawPopup(
   return needRedraw;
 }
 
-std::pair<Gui::Panel*,GuiElem*> Gui::findElem(ElemID id)
+void Gui::setNeedRender(ElemID id)
 {
-  for (auto& p : _panels) {
-    GuiElem* e = findByElemID(p->root, id);
-    if (e) { return {p.get(),e}; }
-  }
-  return {nullptr,nullptr};
+  if (id == 0) { return; }
+  const auto [panelP,elemP] = findElem(id);
+  if (panelP) { setNeedRender(*panelP); }
 }
 
-GuiElem* Gui::findEventElem(PanelID pid, EventID eid)
+void Gui::indexPanel(Panel& p)
 {
-  for (auto& p : _panels) {
-    if (pid != 0 && pid != p->id) { continue; }
-    GuiElem* e = findByEventID(p->root, eid);
-    if (e) { return e; }
-  }
-  return nullptr;
+  forEachElem(p.root, [&](GuiElem& e) {
+    _elemIndex[e._id] = {&p, &e};
+    if (e.eid != 0) {
+      // first element found has priority for duplicate event IDs
+      _eventIndex.try_emplace(eventKey(p.id, e.eid), &p, &e);
+    }
+  });
 }
 
-const GuiElem* Gui::findEventElem(PanelID pid, EventID eid) const
+void Gui::unindexPanel(Panel& p)
 {
-  for (auto& p : _panels) {
-    if (pid != 0 && pid != p->id) { continue; }
-    const GuiElem* e = findByEventID(p->root, eid);
-    if (e) { return e; }
+  forEachElem(p.root, [&](GuiElem& e) {
+    _elemIndex.erase(e._id);
+    if (e.eid != 0) { _eventIndex.erase(eventKey(p.id, e.eid)); }
+  });
+}
+
+std::pair<Gui::Panel*,GuiElem*> Gui::findElem(ElemID id)
+{
+  const auto itr = _elemIndex.find(id);
+  if (itr == _elemIndex.end()) { return {nullptr,nullptr}; }
+  return itr->second;
+}
+
+const std::pair<Gui::Panel*,GuiElem*>* Gui::findEventEntry(
+  PanelID pid, EventID eid) const
+{
+  GX_ASSERT(eid != 0);
+  if (pid != 0) {
+    const auto itr = _eventIndex.find(eventKey(pid, eid));
+    if (itr != _eventIndex.end()) { return &itr->second; }
+  } else {
+    // check all panels (top panel first)
+    for (auto& p : _panels) {
+      const auto itr = _eventIndex.find(eventKey(p->id, eid));
+      if (itr != _eventIndex.end()) { return &itr->second; }
+    }
   }
   return nullptr;
 }
@@ -1643,7 +2472,7 @@ void Gui::addEvent(const Panel& p, const GuiElem& e, int item_no, int64_t t)
       }
 
       if (update) {
-        _needRender = true;
+        setNeedRender(target->_id);
         if (_focusID == target->_id) {
           _focusCursorPos = _focusRangeStart = lengthUTF8(target->entry().text);
           _focusEntryOffset = 0;
@@ -1664,6 +2493,7 @@ Gui::PanelPtr Gui::removePanel(PanelID id)
     if ((*i)->id == id) {
       auto ptr = std::move(*i);
       _panels.erase(i);
+      unindexPanel(*ptr);
       return ptr;
     }
   }
@@ -9,12 +9,15 @@
 #include "GuiElem.hh"
 #include "GuiTheme.hh"
 #include "DrawList.hh"
+#include "ShapeCache.hh"
+#include "TextLayoutCache.hh"
 #include "Align.hh"
 #include "Rect.hh"
 #include "Types.hh"
 #include <string>
 #include <string_view>
 #include <vector>
+#include <unordered_map>
 #include <memory>
 
 
@@ -23,6 +26,7 @@ namespace gx {
 
   class Gui;
   struct GuiEvent;
+  struct GuiStats;
 
   // panel flags
   constexpr int PANEL_FLOATING = 1;
@@ -40,6 +44,14 @@ struct gx::GuiEvent
   [[nodiscard]] explicit operator bool() const { return eid != 0; }
 };
 
+struct gx::GuiStats
+{
+  int64_t layoutNsec = 0;  // total time of layout updates
+  int64_t renderNsec = 0;  // total time of drawList updates
+  int layouts = 0;         // updates w/ layout changes
+  int renders = 0;         // updates w/ drawList changes
+};
+
 
 class gx::Gui
 {
@@ -54,6 +66,8 @@ class gx::Gui
   void lowerPanel(PanelID id);
 
   bool getPanelLayout(PanelID id, Rect& layout) const;
+  bool getElemLayout(PanelID pid, EventID eid, Rect& layout) const;
+    // element area in window coordinates (pid of 0 checks all panels)
   [[nodiscard]] PanelID topPanel() const {
     return _panels.empty() ? 0 : _panels.front()->id; }
   [[nodiscard]] PanelID bottomPanel() const {
@@ -63,6 +77,28 @@ class gx::Gui
     // process events & update drawLists
     // returns true if redraw is required (same as needRedraw())
 
+  bool update(EventState& es, int allEvents, int width, int height) {
+    return doUpdate(nullptr, es, allEvents, width, height); }
+    // window-less update (for testing/benchmarks)
+    // - allEvents: event mask before any events were removed from es
+    // - width,height: window size (limits panel movement)
+
+  [[nodiscard]] const GuiStats& stats() const { return _stats; }
+  void resetStats() { _stats = {}; _textCache.resetStats(); }
+    // accumulated layout/drawList update times (for profiling)
+
+  [[nodiscard]] const TextLayoutCache& textCache() const {
+    return _textCache; }
+    // text layout cache (for hit rate/time saved stats)
+  void clearTextCache() { _textCache.clear(); _needRender = true; }
+    // frees cached layouts (entries of replaced fonts aren't used again)
+    // (cache is also cleared by clear() & deletePanel())
+
+  [[nodiscard]] int64_t nextDeadline() const;
+    // time (same clock as Window::lastPollTime()) of next required update
+    // for cursor blink/button repeat, -1 if no timed update is pending
+    // (use w/ Window::waitEvents() to sleep until next update when idle)
+
   [[nodiscard]] const GuiEvent& event() const { return _event; }
     // event details from last update
 
@@ -97,6 +133,8 @@ class gx::Gui
         return e->label().text;
       case GUI_ENTRY:
         return e->entry().text;
+      case GUI_TEXTEDIT:
+        return e->textEdit().text.text();
       default:
         return {};
     }
@@ -109,7 +147,12 @@ class gx::Gui
 
   [[nodiscard]] int getItemNo(PanelID pid, EventID eid) const {
     const GuiElem* e = findEventElem(pid, eid);
-    return (e == nullptr || e->type != GUI_LISTSELECT) ? 0 : e->item().no;
+    if (e == nullptr) { return 0; }
+    switch (e->type) {
+      case GUI_LISTSELECT: return e->item().no;
+      case GUI_LIST:       return e->list().selected;
+      default:             return 0;
+    }
   }
 
   [[nodiscard]] std::string eventText() const {
@@ -123,19 +166,40 @@ class gx::Gui
   bool setBool(PanelID pid, EventID eid, bool val);
   bool setItemNo(PanelID pid, EventID eid, int itemNo);
 
+  bool setListRows(PanelID pid, EventID eid, int rows);
+    // update list row count
+    // (also use to redraw list if row text changed)
+
   // TODO: methods to update menu/listselect items
 
  private:
+  struct HitGrid {
+    // uniform grid of element rects for mouse hit testing
+    // (rebuilt on first mouse event after panel layout changes)
+    std::vector<GuiElem*> elems;     // hit test elements in priority order
+    std::vector<uint32_t> cellStart; // cell ranges in cellElems
+    std::vector<uint32_t> cellElems; // elems indices per cell
+    float x = 0, y = 0, cellSize = 0;
+    int cols = 0, rows = 0;
+    bool valid = false;
+  };
+
   struct Panel {
     // set at creation
     GuiElem root;
     const GuiTheme* theme;
     int flags;
+    std::vector<GuiElem> elems{}; // all other elements (set by addPanel)
+      // (children of each element are contiguous, element blocks are in
+      //  tree pre-order, size is fixed so element pointers stay valid)
 
     // other attributes
     PanelID id = 0;
     Rect layout{};
-    bool needLayout = false;
+    DrawList dl{};            // cached panel render data
+    std::vector<GuiElem*> layoutElems{}; // elements needing layout update
+    HitGrid hit{};
+    bool needRender = true;
   };
 
   // element definition
@@ -143,6 +207,11 @@ class gx::Gui
   std::vector<PanelPtr> _panels;
   ElemID _lastElemID = 0;
 
+  // element lookup indexes (updated when panels are added/removed)
+  std::unordered_map<ElemID,std::pair<Panel*,GuiElem*>> _elemIndex;
+  std::unordered_map<uint64_t,std::pair<Panel*,GuiElem*>> _eventIndex;
+    // key: (PanelID,EventID)
+
   // current state
   DrawList _data;
   RGBA8 _bgColor = 0;
@@ -163,6 +232,7 @@ class gx::Gui
   int64_t _heldTime = 0;
   int64_t _repeatDelay = -1;        // negative value disables repeat
   std::size_t _focusCursorPos = 0;  // character pos of cursor
+    // (byte pos for GUI_TEXTEDIT)
   std::size_t _focusRangeStart = 0; // start selected range from cursorPos
     // if cursorPos != rangeStart, there is a selected range from
     //   min(pos,rs) to max(pos,rs)
@@ -171,14 +241,25 @@ class gx::Gui
   int64_t _lastCursorUpdate = 0;
   uint32_t _cursorBlinkTime = 0; // cached theme value
   bool _cursorState = false;  // track cursor blinking
-  bool _needRender = true;
+  bool _needRender = true;   // rebuild _data (panels w/ needRender are redrawn)
   bool _needRedraw = false;
   bool _textChanged = false;
+  std::string _listText;        // list row/text edit line buffer
+  GuiStats _stats;
+  ShapeCache _shapeCache;       // element background geometry
+  TextLayoutCache _textCache;   // element text layouts
 
   PanelID addPanel(PanelPtr ptr, float x, float y, Align align);
   void layout(Panel& p, float x, float y, Align align);
-  void processMouseEvent(Window& win, EventState& es);
+  void updateLayout(Panel& p, GuiElem& def);
+  bool doUpdate(Window* win, EventState& es, int allEvents,
+                int width, int height);
+  void processMouseEvent(Window* win, EventState& es, int allEvents,
+                         int width, int height);
+  void updateHitGrid(Panel& p);
+  [[nodiscard]] GuiElem* findHitElem(Panel& p, float x, float y);
   void processTextEvent(EventState& es);
+  void processTextEditEvent(EventState& es, Panel& p, GuiElem& e);
   void addEntryText(GuiElem& e, std::string_view text);
   void addEntryChar(GuiElem::EntryProps& entry, int32_t code);
   void setFocus(const GuiElem* e, int64_t now);
@@ -189,9 +270,32 @@ class gx::Gui
                 const Style* style);
   bool drawPopup(Panel& p, GuiElem& def, DrawContext2D& dc, DrawContext2D& dc2);
 
+  void indexPanel(Panel& p);
+  void unindexPanel(Panel& p);
+  [[nodiscard]] static constexpr uint64_t eventKey(PanelID pid, EventID eid) {
+    return (uint64_t(uint32_t(pid)) << 32) | uint32_t(eid); }
+
   [[nodiscard]] std::pair<Panel*,GuiElem*> findElem(ElemID id);
-  [[nodiscard]] GuiElem* findEventElem(PanelID pid, EventID eid);
-  [[nodiscard]] const GuiElem* findEventElem(PanelID pid, EventID eid) const;
+  [[nodiscard]] std::pair<Panel*,GuiElem*> findEvent(
+    PanelID pid, EventID eid) {
+    if (const auto* x = findEventEntry(pid, eid)) { return *x; }
+    return {nullptr,nullptr}; }
+  [[nodiscard]] std::pair<const Panel*,const GuiElem*> findEvent(
+    PanelID pid, EventID eid) const {
+    if (const auto* x = findEventEntry(pid, eid)) { return *x; }
+    return {nullptr,nullptr}; }
+    // pid of 0 checks all panels
+  [[nodiscard]] const std::pair<Panel*,GuiElem*>* findEventEntry(
+    PanelID pid, EventID eid) const;
+    // returns _eventIndex value (null if not found)
+  [[nodiscard]] GuiElem* findEventElem(PanelID pid, EventID eid) {
+    return findEvent(pid, eid).second; }
+  [[nodiscard]] const GuiElem* findEventElem(PanelID pid, EventID eid) const {
+    return findEvent(pid, eid).second; }
+
+  void setNeedRender(Panel& p) { p.needRender = true; _needRender = true; }
+  void setNeedRender(ElemID id);
+    // mark panel (or panel containing element) for redraw
 
   void clearHeld() {
     _heldID = 0;
@@ -212,7 +316,7 @@ gx::PanelID gx::Gui::newPanel(
   ElemT&& elems)
 {
   PanelPtr ptr{new Panel{
-      {GUI_PANEL, Align::top_left, 0, {std::forward<ElemT>(elems)}},
+      {GUI_PANEL, Align::top_left, 0, guiElems(std::forward<ElemT>(elems))},
       &theme, flags}};
   return addPanel(std::move(ptr), x, y, align);
 }
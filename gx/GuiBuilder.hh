@@ -17,24 +17,26 @@ namespace gx {
 
   // HFrame
   template<class... Elems>
-  [[nodiscard]] inline GuiElem guiHFrame(const Elems&... elems) {
-    return {GUI_HFRAME, Align::top_left, 0, {elems...}};
+  [[nodiscard]] inline GuiElem guiHFrame(Elems&&... elems) {
+    return {GUI_HFRAME, Align::top_left, 0,
+            guiElems(std::forward<Elems>(elems)...)};
   }
 
   template<class... Elems>
-  [[nodiscard]] inline GuiElem guiHFrame(Align align, const Elems&... elems) {
-    return {GUI_HFRAME, align, 0, {elems...}};
+  [[nodiscard]] inline GuiElem guiHFrame(Align align, Elems&&... elems) {
+    return {GUI_HFRAME, align, 0, guiElems(std::forward<Elems>(elems)...)};
   }
 
   // VFrame
   template<class... Elems>
-  [[nodiscard]] inline GuiElem guiVFrame(const Elems&... elems) {
-    return {GUI_VFRAME, Align::top_left, 0, {elems...}};
+  [[nodiscard]] inline GuiElem guiVFrame(Elems&&... elems) {
+    return {GUI_VFRAME, Align::top_left, 0,
+            guiElems(std::forward<Elems>(elems)...)};
   }
 
   template<class... Elems>
-  [[nodiscard]] inline GuiElem guiVFrame(Align align, const Elems&... elems) {
-    return {GUI_VFRAME, align, 0, {elems...}};
+  [[nodiscard]] inline GuiElem guiVFrame(Align align, Elems&&... elems) {
+    return {GUI_VFRAME, align, 0, guiElems(std::forward<Elems>(elems)...)};
   }
 
   // Margin Set
@@ -56,7 +58,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -68,7 +70,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -80,7 +82,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -93,7 +95,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -106,7 +108,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -119,7 +121,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -131,7 +133,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -144,7 +146,7 @@ namespace gx {
     label.text = text;
     label.minLength = minLength;
     label.minLines = minLines;
-    e.props = label;
+    e.props = std::move(label);
     return e;
   }
 
@@ -160,24 +162,25 @@ namespace gx {
 
   // Button
   // (triggered on button release)
-  [[nodiscard]] inline GuiElem guiButton(EventID id, const GuiElem& elem)
+  [[nodiscard]] inline GuiElem guiButton(EventID id, GuiElem elem)
   {
-    GuiElem e{GUI_BUTTON, Align::top_left, id, {elem}};
+    GuiElem e{GUI_BUTTON, Align::top_left, id, guiElems(std::move(elem))};
     e.props = GuiElem::ButtonProps{};
     return e;
   }
 
   [[nodiscard]] inline GuiElem guiButton(
-    EventID id, Align align, const GuiElem& elem)
+    EventID id, Align align, GuiElem elem)
   {
-    GuiElem e{GUI_BUTTON, align, id, {elem}};
+    GuiElem e{GUI_BUTTON, align, id, guiElems(std::move(elem))};
     e.props = GuiElem::ButtonProps{};
     return e;
   }
 
   [[nodiscard]] inline GuiElem guiButton(EventID id, std::string_view text)
   {
-    GuiElem e{GUI_BUTTON, Align::top_left, id, {guiLabel(Align::center, text)}};
+    GuiElem e{GUI_BUTTON, Align::top_left, id,
+              guiElems(guiLabel(Align::center, text))};
     e.props = GuiElem::ButtonProps{};
     return e;
   }
@@ -185,7 +188,7 @@ namespace gx {
   [[nodiscard]] inline GuiElem guiButton(
     EventID id, Align align, std::string_view text)
   {
-    GuiElem e{GUI_BUTTON, align, id, {guiLabel(Align::center, text)}};
+    GuiElem e{GUI_BUTTON, align, id, guiElems(guiLabel(Align::center, text))};
     e.props = GuiElem::ButtonProps{};
     return e;
   }
@@ -193,17 +196,17 @@ namespace gx {
   // ButtonPress
   // (triggered on initial button press, holding repeats if repeat_delay >= 0)
   [[nodiscard]] inline GuiElem guiButtonPress(
-    EventID id, int64_t repeat_delay, const GuiElem& elem)
+    EventID id, int64_t repeat_delay, GuiElem elem)
   {
-    GuiElem e{GUI_BUTTON_PRESS, Align::top_left, id, {elem}};
+    GuiElem e{GUI_BUTTON_PRESS, Align::top_left, id, guiElems(std::move(elem))};
     e.props = GuiElem::ButtonProps{.repeatDelay = repeat_delay};
     return e;
   }
 
   [[nodiscard]] inline GuiElem guiButtonPress(
-    EventID id, Align align, int64_t repeat_delay, const GuiElem& elem)
+    EventID id, Align align, int64_t repeat_delay, GuiElem elem)
   {
-    GuiElem e{GUI_BUTTON_PRESS, align, id, {elem}};
+    GuiElem e{GUI_BUTTON_PRESS, align, id, guiElems(std::move(elem))};
     e.props = GuiElem::ButtonProps{.repeatDelay = repeat_delay};
     return e;
   }
@@ -212,7 +215,7 @@ namespace gx {
     EventID id, int64_t repeat_delay, std::string_view text)
   {
     GuiElem e{GUI_BUTTON_PRESS, Align::top_left, id,
-              {guiLabel(Align::center, text)}};
+              guiElems(guiLabel(Align::center, text))};
     e.props = GuiElem::ButtonProps{.repeatDelay = repeat_delay};
     return e;
   }
@@ -220,24 +223,25 @@ namespace gx {
   [[nodiscard]] inline GuiElem guiButtonPress(
     EventID id, Align align, int64_t repeat_delay, std::string_view text)
   {
-    GuiElem e{GUI_BUTTON_PRESS, align, id, {guiLabel(Align::center, text)}};
+    GuiElem e{GUI_BUTTON_PRESS, align, id,
+              guiElems(guiLabel(Align::center, text))};
     e.props = GuiElem::ButtonProps{.repeatDelay = repeat_delay};
     return e;
   }
 
   // Checkbox
   [[nodiscard]] inline GuiElem guiCheckbox(
-    EventID id, bool set, const GuiElem& label)
+    EventID id, bool set, GuiElem label)
   {
-    GuiElem e{GUI_CHECKBOX, Align::left, id, {label}};
+    GuiElem e{GUI_CHECKBOX, Align::left, id, guiElems(std::move(label))};
     e.props = GuiElem::CheckboxProps{.set = set};
     return e;
   }
 
   [[nodiscard]] inline GuiElem guiCheckbox(
-    EventID id, Align align, bool set, const GuiElem& label)
+    EventID id, Align align, bool set, GuiElem label)
   {
-    GuiElem e{GUI_CHECKBOX, align, id, {label}};
+    GuiElem e{GUI_CHECKBOX, align, id, guiElems(std::move(label))};
     e.props = GuiElem::CheckboxProps{.set = set};
     return e;
   }
@@ -245,7 +249,8 @@ namespace gx {
   [[nodiscard]] inline GuiElem guiCheckbox(
     EventID id, bool set, std::string_view label)
   {
-    GuiElem e{GUI_CHECKBOX, Align::top_left, id, {guiLabel(Align::left, label)}};
+    GuiElem e{GUI_CHECKBOX, Align::top_left, id,
+              guiElems(guiLabel(Align::left, label))};
     e.props = GuiElem::CheckboxProps{.set = set};
     return e;
   }
@@ -253,56 +258,63 @@ namespace gx {
   [[nodiscard]] inline GuiElem guiCheckbox(
     EventID id, Align align, bool set, std::string_view label)
   {
-    GuiElem e{GUI_CHECKBOX, align, id, {guiLabel(Align::left, label)}};
+    GuiElem e{GUI_CHECKBOX, align, id, guiElems(guiLabel(Align::left, label))};
     e.props = GuiElem::CheckboxProps{.set = set};
     return e;
   }
 
+  // Popup (menu/list select item container)
+  template<class... Elems>
+  [[nodiscard]] inline GuiElem guiPopup(Elems&&... items) {
+    return {GUI_POPUP, Align::top_left, 0,
+            guiElems(guiVFrame(std::forward<Elems>(items)...))};
+  }
+
   // Menu
   template<class... Elems>
   [[nodiscard]] inline GuiElem guiMenu(
-    EventID id, std::string_view text, const Elems&... items)
+    EventID id, std::string_view text, Elems&&... items)
   {
     return {GUI_MENU, Align::top_left, id,
-            {guiLabel(Align::center, text),
-             GuiElem{GUI_POPUP, Align::top_left, 0, {guiVFrame(items...)}}}};
+            guiElems(guiLabel(Align::center, text),
+                     guiPopup(std::forward<Elems>(items)...))};
   }
 
   [[nodiscard]] inline GuiElem guiMenuItem(int no, std::string_view text)
   {
     GuiElem e{GUI_MENU_ITEM, Align::justify, 0,
-              {guiLabel(Align::center_left, text)}};
+              guiElems(guiLabel(Align::center_left, text))};
     e.props = GuiElem::ItemProps{.no = no};
     return e;
   }
 
   template<class... Elems>
   [[nodiscard]] inline GuiElem guiSubMenu(
-    std::string_view text, const Elems&... items)
+    std::string_view text, Elems&&... items)
   {
     return {GUI_SUBMENU, Align::justify, 0,
-            {guiLabel(Align::center_left, text),
-             GuiElem{GUI_POPUP, Align::top_left, 0, {guiVFrame(items...)}}}};
+            guiElems(guiLabel(Align::center_left, text),
+                     guiPopup(std::forward<Elems>(items)...))};
   }
 
   // List Select
   template<class... Elems>
-  [[nodiscard]] inline GuiElem guiListSelect(EventID id, const Elems&... items)
+  [[nodiscard]] inline GuiElem guiListSelect(EventID id, Elems&&... items)
   {
     GuiElem e{GUI_LISTSELECT, Align::top_left, id,
-              {guiLabel(""), // copy of label from selected item
-               GuiElem{GUI_POPUP, Align::top_left, 0, {guiVFrame(items...)}}}};
+              guiElems(guiLabel(""), // copy of label from selected item
+                       guiPopup(std::forward<Elems>(items)...))};
     e.props = GuiElem::ItemProps{};
     return e;
   }
 
   template<class... Elems>
   [[nodiscard]] inline GuiElem guiListSelect(
-    EventID id, Align align, const Elems&... items)
+    EventID id, Align align, Elems&&... items)
   {
     GuiElem e{GUI_LISTSELECT, align, id,
-              {guiLabel(""), // copy of label from selected item
-               GuiElem{GUI_POPUP, Align::top_left, 0, {guiVFrame(items...)}}}};
+              guiElems(guiLabel(""), // copy of label from selected item
+                       guiPopup(std::forward<Elems>(items)...))};
     e.props = GuiElem::ItemProps{};
     return e;
   }
@@ -310,11 +322,54 @@ namespace gx {
   [[nodiscard]] inline GuiElem guiListSelectItem(int no, std::string_view text)
   {
     GuiElem e{GUI_LISTSELECT_ITEM, Align::justify, 0,
-              {guiLabel(Align::center_left, text)}};
+              guiElems(guiLabel(Align::center_left, text))};
     e.props = GuiElem::ItemProps{.no = no};
     return e;
   }
 
+  // List
+  [[nodiscard]] inline GuiElem guiList(
+    EventID id, Align align, float size, int visibleRows, int rows,
+    std::function<void(int,std::string&)> rowText)
+  {
+    GuiElem e{GUI_LIST, align, id};
+    GuiElem::ListProps list;
+    list.rowText = std::move(rowText);
+    list.rows = rows;
+    list.visibleRows = visibleRows;
+    list.size = size;
+    e.props = std::move(list);
+    return e;
+  }
+
+  [[nodiscard]] inline GuiElem guiList(
+    EventID id, float size, int visibleRows, int rows,
+    std::function<void(int,std::string&)> rowText)
+  {
+    return guiList(id, Align::top_left, size, visibleRows, rows,
+                   std::move(rowText));
+  }
+
+  // TextEdit
+  [[nodiscard]] inline GuiElem guiTextEdit(
+    EventID id, Align align, float size, int visibleLines,
+    std::string_view text = {})
+  {
+    GuiElem e{GUI_TEXTEDIT, align, id};
+    GuiElem::TextEditProps te;
+    te.text.assign(text);
+    te.size = size;
+    te.visibleLines = visibleLines;
+    e.props = std::move(te);
+    return e;
+  }
+
+  [[nodiscard]] inline GuiElem guiTextEdit(
+    EventID id, float size, int visibleLines, std::string_view text = {})
+  {
+    return guiTextEdit(id, Align::top_left, size, visibleLines, text);
+  }
+
   // Entry
   [[nodiscard]] inline GuiElem guiEntry(
     EventID id, Align align, EntryType type, float size,
@@ -328,7 +383,7 @@ namespace gx {
     entry.maxChars = maxChars;
     entry.type = type;
     entry.align = textAlign;
-    e.props = entry;
+    e.props = std::move(entry);
     return e;
   }
 
@@ -401,7 +456,7 @@ namespace gx {
     image.texId = tid;
     image.texCoord0 = t0;
     image.texCoord1 = t1;
-    e.props = image;
+    e.props = std::move(image);
     return e;
   }
 
@@ -411,7 +466,8 @@ namespace gx {
   }
 
   [[nodiscard]] inline GuiElem guiTitleBar(std::string_view text) {
-    return {GUI_TITLEBAR, Align::hjustify, 0, {guiLabel(Align::center, text)}};
+    return {GUI_TITLEBAR, Align::hjustify, 0,
+            guiElems(guiLabel(Align::center, text))};
   }
 
   // VTitleBar
@@ -420,6 +476,7 @@ namespace gx {
   }
 
   [[nodiscard]] inline GuiElem guiVTitleBar(std::string_view text) {
-    return {GUI_TITLEBAR, Align::vjustify, 0, {guiVLabel(Align::center, text)}};
+    return {GUI_TITLEBAR, Align::vjustify, 0,
+            guiElems(guiVLabel(Align::center, text))};
   }
 }
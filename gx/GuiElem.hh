@@ -4,13 +4,17 @@
 //
 
 #pragma once
+#include "TextBuffer.hh"
 #include "Renderer.hh"
 #include "Align.hh"
 #include "Types.hh"
 #include <vector>
 #include <string>
 #include <initializer_list>
+#include <span>
 #include <variant>
+#include <functional>
+#include <utility>
 
 
 namespace gx {
@@ -41,6 +45,8 @@ namespace gx {
     GUI_LISTSELECT,      // as GUI_MENU
     GUI_LISTSELECT_ITEM, // as GUI_MENU_ITEM
     GUI_ENTRY,           // activated if changed on enter/tab/click-away
+    GUI_LIST,            // activated on row click (only visible rows drawn)
+    GUI_TEXTEDIT,        // multi-line entry, activated if changed on click-away
   };
 
   enum EntryType {
@@ -68,6 +74,8 @@ class gx::GuiElem
  public:
   // shared properties
   std::vector<GuiElem> elems;  // child elements
+    // (moved to panel element storage when panel is added, use children()
+    //  to access them afterwards)
   GuiElemType type;
   Align align;
   EventID eid;
@@ -107,6 +115,22 @@ class gx::GuiElem
     float tx = 0; // cache last text x pos for mouse click cursor pos calc
   };
 
+  struct ListProps {
+    std::function<void(int,std::string&)> rowText; // set text for row
+    int rows = 0;        // total row count
+    int visibleRows;     // rows shown at once (sets element height)
+    float size;          // width in characters
+    int selected = -1;   // selected row (-1 for none)
+    float scroll = 0;    // scroll offset in pixels
+  };
+
+  struct TextEditProps {
+    TextBuffer text;
+    float size;          // width in characters
+    int visibleLines;    // lines shown at once (sets element height)
+    float scroll = 0;    // scroll offset in pixels
+  };
+
   struct ImageProps {
     float width, height;
     TextureID texId;
@@ -119,6 +143,8 @@ class gx::GuiElem
     CheckboxProps, // CHECKBOX
     ItemProps,     // LISTSELECT,LISTSELECT_ITEM,MENU_ITEM
     EntryProps,    // ENTRY
+    ListProps,     // LIST
+    TextEditProps, // TEXTEDIT
     ImageProps     // IMAGE
     > props;
 
@@ -131,21 +157,35 @@ class gx::GuiElem
   GX_GETTER(checkbox,CheckboxProps)
   GX_GETTER(item,ItemProps)
   GX_GETTER(entry,EntryProps)
+  GX_GETTER(list,ListProps)
+  GX_GETTER(textEdit,TextEditProps)
   GX_GETTER(image,ImageProps)
 #undef GX_GETTER
 
   // layout state
   ElemID _id = 0;
+  GuiElem* _parent = nullptr;
+  GuiElem* _children = nullptr; // child elements in panel storage
+  uint32_t _childCount = 0;
   float _x = 0, _y = 0;  // element position relative to panel
   float _w = 0, _h = 0;  // element size
+  float _nw = 0, _nh = 0; // natural element size (before justify resize)
     // NOTE: position/size doesn't include margins
   bool _active = false;  // popup/menu activated
   bool _enabled = true;
+  bool _needLayout = false;
 
   GuiElem(GuiElemType t, Align a, EventID i)
     : type{t}, align{a}, eid{i} { }
   GuiElem(GuiElemType t, Align a, EventID i, std::initializer_list<GuiElem> x)
     : elems{x}, type{t}, align{a}, eid{i} { }
+  GuiElem(GuiElemType t, Align a, EventID i, std::vector<GuiElem>&& x)
+    : elems{std::move(x)}, type{t}, align{a}, eid{i} { }
+
+  [[nodiscard]] std::span<GuiElem> children() {
+    return {_children, _childCount}; }
+  [[nodiscard]] std::span<const GuiElem> children() const {
+    return {_children, _childCount}; }
 
   [[nodiscard]] bool contains(float x, float y) const {
     return (x >= _x) && (x < (_x + _w)) && (y >= _y) && (y < (_y + _h));
@@ -157,3 +197,18 @@ class gx::GuiElem
   [[nodiscard]] float layoutW() const { return _w + marginW(); }
   [[nodiscard]] float layoutH() const { return _h + marginH(); }
 };
+
+
+// **** GuiElem functions ****
+namespace gx {
+  // create child element list, moving elements instead of copying
+  // (initializer_list elements are const & must be copied)
+  template<class... Elems>
+  [[nodiscard]] inline std::vector<GuiElem> guiElems(Elems&&... elems)
+  {
+    std::vector<GuiElem> v;
+    v.reserve(sizeof...(elems));
+    (v.push_back(std::forward<Elems>(elems)), ...);
+    return v;
+  }
+}
@@ -83,7 +83,7 @@ struct gx::GuiTheme
   Style listSelectItemDisable = {
     packRGBA8(.5f,.5f,.5f,1.0f), 0};
 
-  Style entry = {
+  Style entry = { // entry styles & margins also used for text edit
     packRGBA8(1.0f,1.0f,1.0f,1.0f), packRGBA8(0.0f,0.0f,.2f,1.0f)};
   Style entryFocus = {
     packRGBA8(1.0f,1.0f,1.0f,1.0f),
@@ -92,6 +92,15 @@ struct gx::GuiTheme
   Style entryDisable = {
     packRGBA8(.5f,.5f,.5f,1.0f), packRGBA8(.15f,.15f,.2f,1.0f)};
 
+  Style list = {
+    packRGBA8(1.0f,1.0f,1.0f,1.0f), packRGBA8(0.0f,0.0f,.2f,1.0f)};
+  Style listDisable = {
+    packRGBA8(.5f,.5f,.5f,1.0f), packRGBA8(.15f,.15f,.2f,1.0f)};
+  Style listRowSelect = {
+    packRGBA8(1.0f,1.0f,1.0f,1.0f), packRGBA8(.3f,.3f,.6f,1.0f)};
+  Style listScrollbar = {
+    0, packRGBA8(.5f,.5f,.5f,1.0f)};
+
   uint16_t entryLeftMargin = 10;
   uint16_t entryRightMargin = 10;
   uint16_t entryTopMargin = 4;
@@ -114,6 +123,9 @@ struct gx::GuiTheme
   uint32_t multiClickTime = 300000; // .3 sec
   uint32_t cursorBlinkTime = 400000; // .4 sec
   uint16_t cursorWidth = 3;
+  uint16_t listScrollbarWidth = 8;
+  uint16_t listScrollRows = 3; // rows scrolled per mouse wheel step
+    // (list scrollbar/scroll settings also used for text edit)
 
   uint16_t panelBorder = 8;
   uint16_t popupBorder = 4; // for menuFrame,listSelectFrame
@@ -237,7 +237,7 @@ void Image::stampSubImage(int x, int y, const Image& img,
 
   const auto sw = std::size_t(iw * img.channels());
   const int srcRow = img.width() * img.channels();
-  const uint8_t* src = img._ptr(ix, iy);
+  const uint8_t* src = img._data + (srcRow * iy) + (ix * img.channels());
   const uint8_t* srcEnd = src + (srcRow * ih);
 
   for (; src != srcEnd; src += srcRow) {
@@ -8,7 +8,6 @@
 //   - thread for OpenGL, glfwMakeContextCurrent(), glfwGetProcAddress(),
 //     glfwSwapInterval(), glfwSwapBuffers() calls
 // TODO: init param to determine which shaders to create
-// TODO: SDF glyph shader
 // TODO: combine viewT & projT for CMD_camera?
 // TODO: support glPolygonOffset() ?
 
@@ -124,6 +123,14 @@ namespace {
         case CMD_lineTo2:      d += 3;  vsize += 2; break;
         case CMD_lineStart2C:  d += 4;  break;
         case CMD_lineTo2C:     d += 4;  vsize += 2; break;
+        case CMD_polyline2: {
+          const uint32_t n = d[1].uval;
+          d += 2 + (n * 2); vsize += n; break;
+        }
+        case CMD_polyline2C: {
+          const uint32_t n = d[1].uval;
+          d += 2 + (n * 3); vsize += n; break;
+        }
         case CMD_triangle2:    d += 7;  vsize += 3; break;
         case CMD_triangle2T:   d += 13; vsize += 3; break;
         case CMD_triangle2C:   d += 10; vsize += 3; break;
@@ -134,6 +141,10 @@ namespace {
         case CMD_quad2TC:      d += 21; vsize += 6; break;
         case CMD_rectangle:    d += 5;  vsize += 6; break;
         case CMD_rectangleT:   d += 9;  vsize += 6; break;
+        case CMD_shapeRectangle:  d += 7;  vsize += 6; break;
+        case CMD_shapeRectangleC: d += 11; vsize += 6; break;
+        case CMD_shapeTriangle2:  d += 11; vsize += 3; break;
+        case CMD_shapeTriangle2C: d += 14; vsize += 3; break;
         case CMD_line3:        d += 7;  vsize += 2; break;
         case CMD_line3C:       d += 9;  vsize += 2; break;
         case CMD_lineStart3:   d += 4;  break;
@@ -191,7 +202,8 @@ namespace {
     uint32_t c;     // color (packed 8-bit RGBA)
     float s, t;     // tex coords
     uint32_t n;     // normal (packed 10-bit XYZ, 2 bits unused)
-    uint32_t m;     // mode (currently unused)
+                    //   (SDF shapes: half width/height, 12.4 fixed point)
+    uint32_t m;     // mode (SDF shapes: radius/border width, 12.4 fixed point)
       // TODO: possible mode values:
       // 16 bits  Z texture coord for texture arrays/3d textures
       //  8 bits  transform function ID
@@ -203,6 +215,18 @@ namespace {
   void vertex2d(Vertex*& ptr, Vec2 pt, uint32_t c, Vec2 tx) {
     *ptr++ = {pt.x,pt.y,0.0f, c, tx.x,tx.y, 0, 0}; }
 
+  void vertexShape(Vertex*& ptr, Vec2 pt, uint32_t c, Vec2 center,
+                   uint32_t n, uint32_t m) {
+    *ptr++ = {pt.x,pt.y,0.0f, c, pt.x-center.x,pt.y-center.y, n, m}; }
+
+  [[nodiscard]] uint32_t packShapeVals(float a, float b)
+  {
+    // two unsigned 12.4 fixed point values (max 4095.9375)
+    const auto fixed = [](float x) {
+      return uint32_t(std::clamp(x * 16.0f + .5f, 0.0f, 65535.0f)); };
+    return fixed(a) | (fixed(b) << 16);
+  }
+
   void vertex3d(Vertex*& ptr, const Vec3& pt, uint32_t c) {
     *ptr++ = {pt.x,pt.y,pt.z, c, 0.0f,0.0f, 0, 0}; }
   void vertex3d(
@@ -287,7 +311,7 @@ class gx::OpenGLRenderer final : public gx::Renderer
   void renderFrame(int64_t usecTime) override;
 
  private:
-  static constexpr int SHADER_COUNT = 5;
+  static constexpr int SHADER_COUNT = 7;
   GLProgram _sp[SHADER_COUNT];
   GLUniform1i _sp_texUnit[SHADER_COUNT];
 
@@ -311,6 +335,7 @@ class gx::OpenGLRenderer final : public gx::Renderer
     int channels = 0;
     int unit = -1;
     bool mipmap = false;
+    bool sdf = false;
   };
   std::unordered_map<TextureID,TextureEntry> _textures;
 
@@ -333,7 +358,9 @@ class gx::OpenGLRenderer final : public gx::Renderer
     // draw
     OP_clear,           // <OP mask> (2)
     OP_drawLines2D,     // <OP first count> (3)
+    OP_drawLineStrip2D, // <OP first count> (3)
     OP_drawTriangles2D, // <OP first count texID> (4)
+    OP_drawShapes2D,    // <OP first count> (3)
     OP_drawLines3D,     // <OP first count> (3)
     OP_drawTriangles3D, // <OP first count texID> (4)
   };
@@ -374,6 +401,11 @@ class gx::OpenGLRenderer final : public gx::Renderer
     first += 2;
   }
 
+  void addLineStrip2D(int32_t& first, int32_t vertices) {
+    if (vertices >= 2) { addOp(OP_drawLineStrip2D, first, vertices); }
+    first += vertices;
+  }
+
   void addTriangles2D(int32_t& first, int32_t vertices, TextureID tid) {
     if (_lastOp == OP_drawTriangles2D) {
       const std::size_t s = _opData.size();
@@ -388,6 +420,15 @@ class gx::OpenGLRenderer final : public gx::Renderer
     first += vertices;
   }
 
+  void addShapes2D(int32_t& first, int32_t vertices) {
+    if (_lastOp == OP_drawShapes2D) {
+      _opData[_opData.size() - 1].ival += vertices;
+    } else {
+      addOp(OP_drawShapes2D, first, vertices);
+    }
+    first += vertices;
+  }
+
   void addLine3D(int32_t& first) {
     if (_lastOp == OP_drawLines3D) {
       _opData[_opData.size() - 1].ival += 2;
@@ -551,6 +592,58 @@ bool OpenGLRenderer<VER>::init(WindowImpl* impl)
     "  fragColor = texture(texUnit, v_texCoord) * v_color * vec4((v_lightD * lt) + v_lightA, 1.0);"
     "}"));
 
+  // 2D SDF shape shader (rounded box w/ optional border)
+  //  tc   - pixel offset from shape center
+  //  norm - half width/height
+  //  mode - corner radius/border width (border width 0 for fill)
+  _sp[5] = makeProgram<VER>(
+    makeVertexShader<VER>(
+      "layout(location = 0) in vec3 in_pos;"
+      "layout(location = 1) in uint in_color;"
+      "layout(location = 2) in vec2 in_tc;"
+      "layout(location = 3) in uint in_norm;"
+      "layout(location = 4) in uint in_mode;"
+      UNIFORM_BLOCK_SRC
+      "out vec4 v_color;"
+      "out vec2 v_pos;"
+      "flat out vec4 v_shape;"
+      "void main() {"
+      "  v_color = unpackUnorm4x8(in_color) * modColor;"
+      "  v_pos = in_tc;"
+      "  v_shape = vec4(float(in_norm & 65535U), float(in_norm >> 16),"
+      "                 float(in_mode & 65535U), float(in_mode >> 16)) / 16.0;"
+      "  gl_Position = cameraT * vec4(in_pos, 1);"
+      "}"),
+    makeFragmentShader<VER>(
+      "in vec4 v_color;"
+      "in vec2 v_pos;"
+      "flat in vec4 v_shape;"
+      "out vec4 fragColor;"
+      "void main() {"
+      "  vec2 q = abs(v_pos) - v_shape.xy + v_shape.z;"
+      "  float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - v_shape.z;"
+      "  if (v_shape.w > 0.0) d = max(d, -(d + v_shape.w));"
+      "  float a = clamp(0.5 - (d / max(fwidth(d), 0.0001)), 0.0, 1.0);"
+      "  if (a == 0.0) discard;"
+      "  fragColor = vec4(v_color.rgb, v_color.a * a);"
+      "}"));
+
+  // SDF texture shader (fonts)
+  //  - distance 0.5 is glyph edge, smoothstep over ~1 pixel in screen
+  //    space gives sharp edges at any scale/rotation
+  _sp[6] = makeProgram<VER>(vshader, makeFragmentShader<VER>(
+    "in vec2 v_texCoord;"
+    "in vec4 v_color;"
+    "uniform sampler2D texUnit;"
+    "out vec4 fragColor;"
+    "void main() {"
+    "  float d = texture(texUnit, v_texCoord).r - 0.5;"
+    "  float w = max(fwidth(d) * 0.7, 0.0001);"
+    "  float a = smoothstep(-w, w, d);"
+    "  if (a == 0.0) discard;"
+    "  fragColor = vec4(v_color.rgb, v_color.a * a);"
+    "}"));
+
   #undef UNIFORM_BLOCK_SRC
 
   // uniform location cache
@@ -619,6 +712,7 @@ TextureHandle OpenGLRenderer<VER>::newTexture(const TextureParams& params)
   auto& t = te.tex;
   t.init(std::max(1, params.levels), texformat, params.width, params.height);
   te.channels = params.channels;
+  te.sdf = params.sdf && (params.channels == 1);
 
   {
     const GLint val = calcMinFilter(params);
@@ -815,6 +909,21 @@ void OpenGLRenderer<VER>::draw(std::span<const DrawList*> lists)
           addLine2D(first);
           break;
         }
+        case CMD_polyline2: {
+          const int32_t n = ival(d);
+          for (int32_t i = 0; i < n; ++i) { vertex2d(ptr, fval2(d), color); }
+          addLineStrip2D(first, n);
+          break;
+        }
+        case CMD_polyline2C: {
+          const int32_t n = ival(d);
+          for (int32_t i = 0; i < n; ++i) {
+            const Vec2 p = fval2(d);
+            vertex2d(ptr, p, uval(d));
+          }
+          addLineStrip2D(first, n);
+          break;
+        }
         case CMD_triangle2: {
           vertex2d(ptr, fval2(d), color);
           vertex2d(ptr, fval2(d), color);
@@ -932,6 +1041,55 @@ void OpenGLRenderer<VER>::draw(std::span<const DrawList*> lists)
           addTriangles2D(first, 6, tid);
           break;
         }
+        case CMD_shapeRectangle:
+        case CMD_shapeRectangleC: {
+          // expand quad by 1 pixel for edge anti-aliasing
+          const Vec2 a = fval2(d), b = fval2(d);
+          const float r = fval(d), bw = fval(d);
+          const Vec2 center = (a + b) * .5f;
+          const Vec2 half = (b - a) * .5f;
+          const Vec2 p0{a.x-1.0f,a.y-1.0f}, p3{b.x+1.0f,b.y+1.0f};
+          const Vec2 p1{p3.x,p0.y}, p2{p0.x,p3.y};
+          uint32_t c0 = color, c1 = color, c2 = color, c3 = color;
+          if (cmd == CMD_shapeRectangleC) {
+            c0 = uval(d); c1 = uval(d); c2 = uval(d); c3 = uval(d);
+          }
+          const uint32_t n = packShapeVals(half.x, half.y);
+          const uint32_t m = packShapeVals(r, bw);
+          vertexShape(ptr, p0, c0, center, n, m);
+          vertexShape(ptr, p1, c1, center, n, m);
+          vertexShape(ptr, p2, c2, center, n, m);
+          vertexShape(ptr, p1, c1, center, n, m);
+          vertexShape(ptr, p3, c3, center, n, m);
+          vertexShape(ptr, p2, c2, center, n, m);
+          addShapes2D(first, 6);
+          break;
+        }
+        case CMD_shapeTriangle2: {
+          const Vec2 center = fval2(d);
+          const float r = fval(d), bw = fval(d);
+          const uint32_t n = packShapeVals(r, r);
+          const uint32_t m = packShapeVals(r, bw);
+          vertexShape(ptr, fval2(d), color, center, n, m);
+          vertexShape(ptr, fval2(d), color, center, n, m);
+          vertexShape(ptr, fval2(d), color, center, n, m);
+          addShapes2D(first, 3);
+          break;
+        }
+        case CMD_shapeTriangle2C: {
+          const Vec2 center = fval2(d);
+          const float r = fval(d), bw = fval(d);
+          const uint32_t n = packShapeVals(r, r);
+          const uint32_t m = packShapeVals(r, bw);
+          const Vec2 p0 = fval2(d); const uint32_t c0 = uval(d);
+          const Vec2 p1 = fval2(d); const uint32_t c1 = uval(d);
+          const Vec2 p2 = fval2(d); const uint32_t c2 = uval(d);
+          vertexShape(ptr, p0, c0, center, n, m);
+          vertexShape(ptr, p1, c1, center, n, m);
+          vertexShape(ptr, p2, c2, center, n, m);
+          addShapes2D(first, 3);
+          break;
+        }
 
         // 3D drawing
         case CMD_line3: {
@@ -1217,6 +1375,28 @@ void OpenGLRenderer<VER>::renderFrame(int64_t usecTime)
         GX_GLCALL(glDrawArrays, GL_LINES, first, count);
         break;
       }
+      case OP_drawLineStrip2D: {
+        const GLint first = (d++)->ival;
+        const GLsizei count = (d++)->ival;
+        const int32_t glCap = newCap & BLEND;
+        if (_currentGLCap != glCap) { setGLCapabilities(glCap); }
+        if (!orthoMode) {
+          ud.cameraT = _orthoT;
+          udChanged = orthoMode = true;
+        }
+        if (udChanged) {
+          _uniformBuf.setSubData(0, sizeof(ud), &ud);
+          udChanged = false;
+        }
+
+        if (lastShader != 0) {
+          lastShader = 0;
+          _sp[0].use();
+        }
+
+        GX_GLCALL(glDrawArrays, GL_LINE_STRIP, first, count);
+        break;
+      }
       case OP_drawTriangles2D: {
         const GLint first = (d++)->ival;
         const GLsizei count = (d++)->ival;
@@ -1236,6 +1416,7 @@ void OpenGLRenderer<VER>::renderFrame(int64_t usecTime)
         //  0 - flat shader
         //  1 - mono texture shader
         //  2 - color texture shader
+        //  6 - SDF texture shader
         int shader = 0;
         bool setUnit = false;
         if (tid != 0) {
@@ -1250,7 +1431,7 @@ void OpenGLRenderer<VER>::renderFrame(int64_t usecTime)
             }
             setUnit = (entry.unit != texUnit);
             texUnit = entry.unit;
-            shader = (entry.channels == 1) ? 1 : 2;
+            shader = entry.sdf ? 6 : ((entry.channels == 1) ? 1 : 2);
           }
         }
 
@@ -1265,6 +1446,28 @@ void OpenGLRenderer<VER>::renderFrame(int64_t usecTime)
         GX_GLCALL(glDrawArrays, GL_TRIANGLES, first, count);
         break;
       }
+      case OP_drawShapes2D: {
+        const GLint first = (d++)->ival;
+        const GLsizei count = (d++)->ival;
+        const int32_t glCap = newCap & BLEND;
+        if (_currentGLCap != glCap) { setGLCapabilities(glCap); }
+        if (!orthoMode) {
+          ud.cameraT = _orthoT;
+          udChanged = orthoMode = true;
+        }
+        if (udChanged) {
+          _uniformBuf.setSubData(0, sizeof(ud), &ud);
+          udChanged = false;
+        }
+
+        if (lastShader != 5) {
+          lastShader = 5;
+          _sp[5].use();
+        }
+
+        GX_GLCALL(glDrawArrays, GL_TRIANGLES, first, count);
+        break;
+      }
       case OP_drawLines3D: {
         const GLint first = (d++)->ival;
         const GLsizei count = (d++)->ival;
@@ -1301,6 +1504,7 @@ void OpenGLRenderer<VER>::renderFrame(int64_t usecTime)
         //  2 - color texture shader
         //  3 - lit flat shader
         //  4 - lit texture shader
+        //  6 - SDF texture shader
         int shader = useLight ? 3 : 0;
         bool setUnit = false;
         if (tid != 0) {
@@ -1318,7 +1522,7 @@ void OpenGLRenderer<VER>::renderFrame(int64_t usecTime)
             if (useLight) {
               shader = 4;
             } else {
-              shader = (entry.channels == 1) ? 1 : 2;
+              shader = entry.sdf ? 6 : ((entry.channels == 1) ? 1 : 2);
             }
           }
         }
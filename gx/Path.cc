@@ -0,0 +1,390 @@
+//
+// gx/Path.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "Path.hh"
+#include "MathUtil.hh"
+#include "Logger.hh"
+#include "Assert.hh"
+#include <algorithm>
+using namespace gx;
+
+
+namespace {
+  constexpr int MAX_SUBDIVIDE_DEPTH = 16;
+
+  [[nodiscard]] constexpr float cross(Vec2 a, Vec2 b) {
+    return (a.x * b.y) - (a.y * b.x); }
+
+  [[nodiscard]] constexpr Vec2 midPt(Vec2 a, Vec2 b) {
+    return {(a.x + b.x) * .5f, (a.y + b.y) * .5f}; }
+
+  void flattenQuad(Vec2 p0, Vec2 c, Vec2 p1, float tolSqr,
+                   std::vector<Vec2>& out, int depth = 0)
+  {
+    // max distance of curve from chord is |p0 - 2c + p1| / 4
+    const Vec2 dd{p0.x - (2.0f * c.x) + p1.x, p0.y - (2.0f * c.y) + p1.y};
+    if (depth >= MAX_SUBDIVIDE_DEPTH || (dd.lengthSqr() * .0625f) <= tolSqr) {
+      out.push_back(p1);
+      return;
+    }
+
+    const Vec2 m0 = midPt(p0, c), m1 = midPt(c, p1), m = midPt(m0, m1);
+    flattenQuad(p0, m0, m, tolSqr, out, depth + 1);
+    flattenQuad(m, m1, p1, tolSqr, out, depth + 1);
+  }
+
+  void flattenCubic(Vec2 p0, Vec2 c1, Vec2 c2, Vec2 p1, float tolSqr,
+                    std::vector<Vec2>& out, int depth = 0)
+  {
+    // flatness bound: max(|3c1 - 2p0 - p1|, |3c2 - p0 - 2p1|)^2 / 16
+    const Vec2 u{(3.0f * c1.x) - (2.0f * p0.x) - p1.x,
+                 (3.0f * c1.y) - (2.0f * p0.y) - p1.y};
+    const Vec2 v{(3.0f * c2.x) - p0.x - (2.0f * p1.x),
+                 (3.0f * c2.y) - p0.y - (2.0f * p1.y)};
+    if (depth >= MAX_SUBDIVIDE_DEPTH
+        || (std::max(u.lengthSqr(), v.lengthSqr()) * .0625f) <= tolSqr) {
+      out.push_back(p1);
+      return;
+    }
+
+    const Vec2 a = midPt(p0, c1), b = midPt(c1, c2), c = midPt(c2, p1);
+    const Vec2 ab = midPt(a, b), bc = midPt(b, c), m = midPt(ab, bc);
+    flattenCubic(p0, a, ab, m, tolSqr, out, depth + 1);
+    flattenCubic(m, bc, c, p1, tolSqr, out, depth + 1);
+  }
+
+  [[nodiscard]] float signedArea(std::span<const Vec2> pts)
+  {
+    float a = 0;
+    for (std::size_t i = 0, j = pts.size() - 1; i < pts.size(); j = i++) {
+      a += cross(pts[j], pts[i]);
+    }
+    return a * .5f;
+  }
+
+  [[nodiscard]] bool insidePolygon(Vec2 pt, std::span<const Vec2> pts)
+  {
+    // even-odd crossing test
+    bool inside = false;
+    for (std::size_t i = 0, j = pts.size() - 1; i < pts.size(); j = i++) {
+      const Vec2 a = pts[i], b = pts[j];
+      if ((a.y > pt.y) != (b.y > pt.y)
+          && pt.x < (a.x + ((b.x - a.x) * (pt.y - a.y) / (b.y - a.y)))) {
+        inside = !inside;
+      }
+    }
+    return inside;
+  }
+
+  [[nodiscard]] bool insideTriangle(Vec2 p, Vec2 a, Vec2 b, Vec2 c, float s)
+  {
+    // s - orientation sign of triangle (points on edges count as inside)
+    return (cross(b - a, p - a) * s) >= 0
+      && (cross(c - b, p - b) * s) >= 0
+      && (cross(a - c, p - c) * s) >= 0;
+  }
+
+  bool mergeHole(std::vector<Vec2>& poly, std::span<const Vec2> hole, float s)
+  {
+    // connect hole to outer polygon with a bridge from the rightmost hole
+    // vertex to a visible polygon vertex (Eberly's method)
+    // returns false if no bridge was found (polygon unchanged)
+    std::size_t mi = 0;
+    for (std::size_t i = 1; i < hole.size(); ++i) {
+      if (hole[i].x > hole[mi].x) { mi = i; }
+    }
+    const Vec2 M = hole[mi];
+
+    // closest intersection of ray M -> +x with polygon edges
+    const std::size_t n = poly.size();
+    float bestX = 0;
+    std::size_t pi = n;
+    for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+      const Vec2 a = poly[j], b = poly[i];
+      if ((a.y > M.y) == (b.y > M.y)) { continue; }
+      const float x = a.x + ((b.x - a.x) * (M.y - a.y) / (b.y - a.y));
+      if (x < M.x || (pi != n && x >= bestX)) { continue; }
+      bestX = x;
+      pi = (a.x > b.x) ? j : i;
+    }
+    if (pi == n) { return false; } // hole not inside polygon
+
+    // check for reflex vertices blocking the bridge
+    const Vec2 I{bestX, M.y};
+    const std::size_t p0i = pi;
+    const Vec2 P0 = poly[p0i];
+    const float triSign = (cross(I - M, P0 - M) >= 0) ? 1.0f : -1.0f;
+    float bestCos = -1.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+      const Vec2 v = poly[i];
+      if (i == p0i || v.x < M.x) { continue; }
+      const Vec2 prev = poly[(i + n - 1) % n], next = poly[(i + 1) % n];
+      const bool reflex = (cross(v - prev, next - v) * s) < 0;
+      if (!reflex || !insideTriangle(v, M, I, P0, triSign)) { continue; }
+
+      const Vec2 d = v - M;
+      const float len = d.length();
+      if (isZero(len)) { continue; }
+      const float c = d.x / len;
+      if (c > bestCos) { bestCos = c; pi = i; }
+    }
+
+    // splice hole into polygon after vertex pi
+    std::vector<Vec2> merged;
+    merged.reserve(n + hole.size() + 2);
+    merged.insert(merged.end(), poly.begin(), poly.begin() + long(pi) + 1);
+    for (std::size_t i = 0; i <= hole.size(); ++i) {
+      merged.push_back(hole[(mi + i) % hole.size()]);
+    }
+    merged.push_back(poly[pi]);
+    merged.insert(merged.end(), poly.begin() + long(pi) + 1, poly.end());
+    poly = std::move(merged);
+    return true;
+  }
+
+  void earClip(std::span<const Vec2> pts, float s, std::vector<Vec2>& out)
+  {
+    const std::size_t n = pts.size();
+    if (n < 3) { return; }
+
+    std::vector<std::size_t> prev(n), next(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      prev[i] = (i + n - 1) % n;
+      next[i] = (i + 1) % n;
+    }
+
+    const auto isEar = [&](std::size_t i) {
+      const Vec2 a = pts[prev[i]], b = pts[i], c = pts[next[i]];
+      if ((cross(b - a, c - b) * s) <= 0) { return false; } // reflex/flat
+
+      for (std::size_t j = next[next[i]]; j != prev[i]; j = next[j]) {
+        const Vec2 p = pts[j];
+        if (p == a || p == b || p == c) { continue; }
+        const Vec2 pp = pts[prev[j]], pn = pts[next[j]];
+        if ((cross(p - pp, pn - p) * s) > 0) { continue; } // convex vertex
+        if (insideTriangle(p, a, b, c, s)) { return false; }
+      }
+      return true;
+    };
+
+    std::size_t remaining = n;
+    std::size_t i = 0, checked = 0;
+    while (remaining > 3) {
+      if (isEar(i) || checked >= remaining) {
+        // ear found (or no ear possible due to degenerate input so
+        // clip anyway to guarantee progress)
+        const Vec2 a = pts[prev[i]], b = pts[i], c = pts[next[i]];
+        if (!isZero(cross(b - a, c - b))) { out.insert(out.end(), {a, b, c}); }
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+        i = next[i];
+        --remaining;
+        checked = 0;
+      } else {
+        i = next[i];
+        ++checked;
+      }
+    }
+
+    const Vec2 a = pts[prev[i]], b = pts[i], c = pts[next[i]];
+    if (!isZero(cross(b - a, c - b))) { out.insert(out.end(), {a, b, c}); }
+  }
+}
+
+
+void Path::moveTo(Vec2 pt)
+{
+  _cmds.push_back(CMD_move);
+  _pts.push_back(pt);
+  changed();
+}
+
+void Path::lineTo(Vec2 pt)
+{
+  _cmds.push_back(CMD_line);
+  _pts.push_back(pt);
+  changed();
+}
+
+void Path::quadTo(Vec2 ctrl, Vec2 pt)
+{
+  _cmds.push_back(CMD_quad);
+  _pts.insert(_pts.end(), {ctrl, pt});
+  changed();
+}
+
+void Path::cubicTo(Vec2 ctrl1, Vec2 ctrl2, Vec2 pt)
+{
+  _cmds.push_back(CMD_cubic);
+  _pts.insert(_pts.end(), {ctrl1, ctrl2, pt});
+  changed();
+}
+
+void Path::close()
+{
+  _cmds.push_back(CMD_close);
+  changed();
+}
+
+void Path::clear()
+{
+  _cmds.clear();
+  _pts.clear();
+  changed();
+}
+
+void Path::setTolerance(float t)
+{
+  t = std::max(t, .001f);
+  if (t != _tolerance) {
+    _tolerance = t;
+    changed();
+  }
+}
+
+const std::vector<Path::Contour>& Path::contours() const
+{
+  if (!_flatValid) { flatten(); }
+  return _contours;
+}
+
+const std::vector<Vec2>& Path::triangles() const
+{
+  if (!_triValid) { triangulate(); }
+  return _triangles;
+}
+
+void Path::flatten() const
+{
+  struct Range { std::size_t start, count; bool closed; };
+  std::vector<Range> ranges;
+  constexpr std::size_t NONE = std::size_t(-1);
+
+  _flatPts.clear();
+  std::size_t start = NONE;
+  Vec2 cur{0,0};
+  const float tolSqr = sqr(_tolerance);
+
+  const auto endContour = [&](bool closed) {
+    if (start == NONE) { return; }
+    if (closed && (_flatPts.size() - start) > 1
+        && _flatPts.back() == _flatPts[start]) {
+      _flatPts.pop_back(); // drop duplicate end point
+    }
+    const std::size_t count = _flatPts.size() - start;
+    if (count >= 2) {
+      ranges.push_back({start, count, closed});
+    } else {
+      _flatPts.resize(start);
+    }
+    start = NONE;
+  };
+
+  const auto beginContour = [&]() {
+    if (start == NONE) {
+      start = _flatPts.size();
+      _flatPts.push_back(cur);
+    }
+  };
+
+  const Vec2* p = _pts.data();
+  for (const CmdType cmd : _cmds) {
+    switch (cmd) {
+      case CMD_move:
+        endContour(false);
+        cur = *p++;
+        beginContour();
+        break;
+      case CMD_line:
+        beginContour();
+        if (*p != cur) { _flatPts.push_back(*p); }
+        cur = *p++;
+        break;
+      case CMD_quad:
+        beginContour();
+        flattenQuad(cur, p[0], p[1], tolSqr, _flatPts);
+        cur = p[1]; p += 2;
+        break;
+      case CMD_cubic:
+        beginContour();
+        flattenCubic(cur, p[0], p[1], p[2], tolSqr, _flatPts);
+        cur = p[2]; p += 3;
+        break;
+      case CMD_close:
+        if (start != NONE) {
+          cur = _flatPts[start];
+          endContour(true);
+        }
+        break;
+    }
+  }
+  endContour(false);
+
+  _contours.clear();
+  for (const Range& r : ranges) {
+    _contours.push_back(
+      {std::span<const Vec2>(_flatPts.data() + r.start, r.count), r.closed});
+  }
+  _flatValid = true;
+}
+
+void Path::triangulate() const
+{
+  const auto& cList = contours();
+  _triangles.clear();
+
+  // nesting depth of each contour (odd depth contours are holes)
+  const std::size_t count = cList.size();
+  std::vector<int> depth(count, 0);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (cList[i].points.size() < 3) { continue; }
+    for (std::size_t j = 0; j < count; ++j) {
+      if (i != j && cList[j].points.size() >= 3
+          && insidePolygon(cList[i].points[0], cList[j].points)) {
+        ++depth[i];
+      }
+    }
+  }
+
+  std::vector<Vec2> poly, hole;
+  std::vector<std::size_t> holes;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto outer = cList[i].points;
+    if (outer.size() < 3 || (depth[i] & 1)) { continue; }
+
+    // outer polygon w/ positive area
+    poly.assign(outer.begin(), outer.end());
+    if (signedArea(poly) < 0) { std::reverse(poly.begin(), poly.end()); }
+
+    // holes directly inside this contour (rightmost hole merged first)
+    holes.clear();
+    for (std::size_t j = 0; j < count; ++j) {
+      if (depth[j] == depth[i] + 1 && cList[j].points.size() >= 3
+          && insidePolygon(cList[j].points[0], outer)) {
+        holes.push_back(j);
+      }
+    }
+
+    const auto maxX = [&](std::size_t h) {
+      float x = cList[h].points[0].x;
+      for (const Vec2& pt : cList[h].points) { x = std::max(x, pt.x); }
+      return x;
+    };
+    std::sort(holes.begin(), holes.end(),
+              [&](std::size_t a, std::size_t b){ return maxX(a) > maxX(b); });
+
+    for (const std::size_t h : holes) {
+      hole.assign(cList[h].points.begin(), cList[h].points.end());
+      if (signedArea(hole) > 0) { std::reverse(hole.begin(), hole.end()); }
+      if (!mergeHole(poly, hole, 1.0f)) {
+        GX_LOG_ERROR("can't connect path hole to outer contour, hole ignored");
+      }
+    }
+
+    earClip(poly, 1.0f, _triangles);
+  }
+
+  _triValid = true;
+}
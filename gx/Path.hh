@@ -0,0 +1,78 @@
+//
+// gx/Path.hh
+// Copyright (C) 2026 Richard Bradley
+//
+// 2D path of line & bezier curve contours
+// (flattened contours & fill triangulation are cached until path changes)
+//
+
+#pragma once
+#include "Types.hh"
+#include <vector>
+#include <span>
+
+
+class gx::Path
+{
+ public:
+  struct Contour {
+    std::span<const Vec2> points;
+    bool closed;
+  };
+
+  Path() = default;
+
+  // copies don't share cache (contour spans point into source's data),
+  // moved vectors keep their buffers so cache stays valid
+  Path(const Path& p)
+    : _cmds{p._cmds}, _pts{p._pts}, _tolerance{p._tolerance} { }
+  Path& operator=(const Path& p) {
+    if (this != &p) {
+      _cmds = p._cmds; _pts = p._pts; _tolerance = p._tolerance;
+      changed();
+    }
+    return *this;
+  }
+  Path(Path&&) noexcept = default;
+  Path& operator=(Path&&) noexcept = default;
+
+  // path construction
+  void moveTo(Vec2 pt);
+  void lineTo(Vec2 pt);
+  void quadTo(Vec2 ctrl, Vec2 pt);
+  void cubicTo(Vec2 ctrl1, Vec2 ctrl2, Vec2 pt);
+  void close();
+  void clear();
+
+  [[nodiscard]] bool empty() const { return _cmds.empty(); }
+
+  void setTolerance(float t);
+  [[nodiscard]] float tolerance() const { return _tolerance; }
+    // max distance (in pixels) between curve & flattened line segments
+
+  // generated data
+  [[nodiscard]] const std::vector<Contour>& contours() const;
+    // flattened contours
+
+  [[nodiscard]] const std::vector<Vec2>& triangles() const;
+    // fill triangles (3 points per triangle)
+    // - even-odd fill rule, nested contours are treated as holes
+    // - open contours are closed for filling
+
+ private:
+  enum CmdType : uint8_t { CMD_move, CMD_line, CMD_quad, CMD_cubic, CMD_close };
+  std::vector<CmdType> _cmds;
+  std::vector<Vec2> _pts;         // command points
+  float _tolerance = .25f;
+
+  // cache
+  mutable std::vector<Vec2> _flatPts;
+  mutable std::vector<Contour> _contours;
+  mutable std::vector<Vec2> _triangles;
+  mutable bool _flatValid = false;
+  mutable bool _triValid = false;
+
+  void changed() { _flatValid = false; _triValid = false; }
+  void flatten() const;
+  void triangulate() const;
+};
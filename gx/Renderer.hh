@@ -45,6 +45,7 @@ namespace gx {
     WrapType wrapS = WrapType::unspecified;
     WrapType wrapT = WrapType::unspecified;
     bool clearTexture = false;
+    bool sdf = false; // 1 channel signed distance field (128 at edge)
   };
 
   class TextureHandle {
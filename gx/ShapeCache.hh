@@ -0,0 +1,85 @@
+//
+// gx/ShapeCache.hh
+// Copyright (C) 2026 Richard Bradley
+//
+// LRU cache of DrawContext2D::shape() draw data
+// - entries are keyed by shape size & Style values, geometry is stored
+//   relative to the shape position & offset when drawn
+// - cache must outlive any DrawContext2D using it
+//
+
+#pragma once
+#include "DrawList.hh"
+#include "Style.hh"
+#include "Types.hh"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+class gx::ShapeCache
+{
+ public:
+  static constexpr std::size_t DEFAULT_SIZE = 64;
+
+  explicit ShapeCache(std::size_t maxEntries = DEFAULT_SIZE)
+    : _maxEntries{maxEntries} { }
+
+  void clear() { _entries.clear(); _hits = 0; _misses = 0; }
+
+  [[nodiscard]] std::size_t size() const { return _entries.size(); }
+  [[nodiscard]] std::size_t maxEntries() const { return _maxEntries; }
+  [[nodiscard]] int64_t hits() const { return _hits; }
+  [[nodiscard]] int64_t misses() const { return _misses; }
+
+ private:
+  friend class DrawContext2D;
+
+  struct Key {
+    float w, h, cornerRadius;
+    RGBA8 fillColor, fillColor2, edgeColor;
+    uint16_t cornerSegments;
+    uint8_t edge, fill;
+    bool sdf;
+
+    [[nodiscard]] bool operator==(const Key&) const = default;
+  };
+
+  struct Entry {
+    Key key;
+    uint64_t lastUse;
+    DrawList dl;          // shape data at position 0,0
+    std::size_t colorPos; // position of first CMD_color in data
+    RGBA8 lastColor;      // last CMD_color value in data (0 if none)
+  };
+
+  std::vector<Entry> _entries;
+  std::size_t _maxEntries;
+  uint64_t _useCount = 0;
+  int64_t _hits = 0, _misses = 0;
+
+  [[nodiscard]] const Entry* find(const Key& key) {
+    for (Entry& e : _entries) {
+      if (e.key == key) { e.lastUse = ++_useCount; ++_hits; return &e; }
+    }
+    ++_misses;
+    return nullptr;
+  }
+
+  [[nodiscard]] Entry& add(const Key& key) {
+    // replace least recently used entry if cache is full
+    Entry* e = nullptr;
+    if (_entries.size() < _maxEntries || _entries.empty()) {
+      e = &_entries.emplace_back();
+    } else {
+      e = &_entries[0];
+      for (Entry& x : _entries) { if (x.lastUse < e->lastUse) { e = &x; } }
+    }
+    e->key = key;
+    e->lastUse = ++_useCount;
+    e->dl.clear();
+    e->colorPos = SIZE_MAX;
+    e->lastColor = 0;
+    return *e;
+  }
+};
@@ -0,0 +1,315 @@
+//
+// gx/TextBuffer.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "TextBuffer.hh"
+#include <algorithm>
+using namespace gx;
+
+
+void TextBuffer::assign(std::string_view text)
+{
+  _original = text;
+  _added.clear();
+  _originalNL.clear();
+  _addedNL.clear();
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    if (text[i] == '\n') { _originalNL.push_back(i); }
+  }
+
+  _blocks.clear();
+  if (!text.empty()) {
+    _blocks.emplace_back().pieces.push_back(
+      makePiece(0, text.size(), false));
+    updateBlocks(0);
+  }
+  _size = text.size();
+  _lineCount = _originalNL.size();
+}
+
+void TextBuffer::insert(std::size_t pos, std::string_view text)
+{
+  if (text.empty()) { return; }
+  pos = std::min(pos, _size);
+
+  const std::size_t addStart = _added.size();
+  const std::size_t len = text.size();
+  _added.append(text);
+  const std::size_t nlStart = _addedNL.size();
+  for (std::size_t x = 0; x < len; ++x) {
+    if (text[x] == '\n') { _addedNL.push_back(addStart + x); }
+  }
+  const std::size_t nl = _addedNL.size() - nlStart;
+
+  if (_blocks.empty()) {
+    _blocks.emplace_back().pieces.push_back({addStart, len, nl, true});
+    updateBlocks(0);
+    _size = len;
+    _lineCount = nl;
+    return;
+  }
+
+  const Location loc = find(pos);
+  _size += len;
+  _lineCount += nl;
+  std::size_t b = loc.block;
+  if (loc.offset == 0 && (loc.piece > 0 || b > 0)) {
+    // extend previous piece (typing at the same position)
+    const std::size_t pb = (loc.piece > 0) ? b : b - 1;
+    Piece& p = (loc.piece > 0)
+      ? _blocks[b].pieces[loc.piece - 1] : _blocks[pb].pieces.back();
+    if (p.added && (p.start + p.len) == addStart) {
+      p.len += len;
+      p.lines += nl;
+      updateBlocks(pb);
+      return;
+    }
+  }
+
+  std::vector<Piece>& pieces = _blocks[b].pieces;
+  const auto itr = pieces.begin() + std::ptrdiff_t(loc.piece);
+  if (loc.offset == 0) {
+    pieces.insert(itr, Piece{addStart, len, nl, true});
+  } else {
+    // split piece
+    const Piece p = *itr;
+    *itr = makePiece(p.start, loc.offset, p.added);
+    pieces.insert(itr + 1,
+                  {Piece{addStart, len, nl, true},
+                   makePiece(p.start + loc.offset, p.len - loc.offset,
+                             p.added)});
+  }
+
+  if (pieces.size() > MAX_BLOCK_PIECES) { splitBlock(b); }
+  updateBlocks(b);
+}
+
+void TextBuffer::erase(std::size_t pos, std::size_t len)
+{
+  if (pos >= _size) { return; }
+  len = std::min(len, _size - pos);
+  if (len == 0) { return; }
+
+  const Location loc = find(pos);
+  const std::size_t first = loc.block;
+  std::size_t i = loc.piece;
+  if (loc.offset > 0) {
+    // split piece so erased range starts on a piece
+    std::vector<Piece>& pieces = _blocks[first].pieces;
+    const Piece p = pieces[i];
+    pieces[i] = makePiece(p.start, loc.offset, p.added);
+    pieces.insert(pieces.begin() + std::ptrdiff_t(i) + 1,
+                  makePiece(p.start + loc.offset, p.len - loc.offset,
+                            p.added));
+    ++i;
+  }
+
+  std::size_t remaining = len, b = first;
+  while (remaining > 0) {
+    std::vector<Piece>& pieces = _blocks[b].pieces;
+    std::size_t end = i;
+    while (end < pieces.size() && pieces[end].len <= remaining) {
+      remaining -= pieces[end++].len;
+    }
+    if (remaining > 0 && end < pieces.size()) {
+      const Piece& p = pieces[end];
+      pieces[end] = makePiece(p.start + remaining, p.len - remaining,
+                              p.added);
+      remaining = 0;
+    }
+    pieces.erase(pieces.begin() + std::ptrdiff_t(i),
+                 pieces.begin() + std::ptrdiff_t(end));
+    calcTotals(_blocks[b]);
+    ++b; i = 0;
+  }
+
+  // remove emptied blocks
+  const auto bEnd = _blocks.begin() + std::ptrdiff_t(b);
+  _blocks.erase(
+    std::remove_if(_blocks.begin() + std::ptrdiff_t(first), bEnd,
+                   [](const Block& x){ return x.pieces.empty(); }),
+    bEnd);
+
+  _size -= len;
+  if (first < _blocks.size()) {
+    // erase inside a piece leaves an extra piece
+    if (_blocks[first].pieces.size() > MAX_BLOCK_PIECES) { splitBlock(first); }
+    updateBlocks(first);
+  }
+  _lineCount = _blocks.empty() ? 0
+    : (_blocks.back().line + _blocks.back().lines);
+}
+
+char TextBuffer::at(std::size_t pos) const
+{
+  if (pos >= _size) { return '\0'; }
+  const Location loc = find(pos);
+  return source(_blocks[loc.block].pieces[loc.piece])[loc.offset];
+}
+
+void TextBuffer::getText(
+  std::size_t pos, std::size_t len, std::string& out) const
+{
+  out.clear();
+  if (pos >= _size) { return; }
+  len = std::min(len, _size - pos);
+  out.reserve(len);
+
+  const Location loc = find(pos);
+  std::size_t i = loc.piece, offset = loc.offset;
+  for (std::size_t b = loc.block; b < _blocks.size() && out.size() < len;
+       ++b, i = 0) {
+    const std::vector<Piece>& pieces = _blocks[b].pieces;
+    for (; i < pieces.size() && out.size() < len; ++i, offset = 0) {
+      const Piece& p = pieces[i];
+      const std::size_t n = std::min(p.len - offset, len - out.size());
+      out.append(source(p) + offset, n);
+    }
+  }
+}
+
+std::string TextBuffer::text() const
+{
+  std::string out;
+  getText(0, _size, out);
+  return out;
+}
+
+std::string_view TextBuffer::chunkAt(std::size_t pos) const
+{
+  if (pos >= _size) { return {}; }
+  const Location loc = find(pos);
+  const Piece& p = _blocks[loc.block].pieces[loc.piece];
+  return {source(p) + loc.offset, p.len - loc.offset};
+}
+
+std::string_view TextBuffer::chunkBefore(std::size_t pos) const
+{
+  pos = std::min(pos, _size);
+  if (pos == 0) { return {}; }
+  const Location loc = find(pos - 1);
+  const Piece& p = _blocks[loc.block].pieces[loc.piece];
+  return {source(p), loc.offset + 1};
+}
+
+std::size_t TextBuffer::lineStart(std::size_t line) const
+{
+  if (line == 0) { return 0; }
+  if (line > _lineCount) { return _size; }
+
+  // find block & piece w/ '\n' ending previous line
+  const auto bItr = std::partition_point(
+    _blocks.begin(), _blocks.end(),
+    [line](const Block& x){ return (x.line + x.lines) < line; });
+  std::size_t n = line - bItr->line, pos = bItr->start;
+  for (const Piece& p : bItr->pieces) {
+    if (n <= p.lines) {
+      const std::vector<std::size_t>& nl = p.added ? _addedNL : _originalNL;
+      const auto itr = std::lower_bound(nl.begin(), nl.end(), p.start);
+      return pos + (itr[std::ptrdiff_t(n - 1)] - p.start) + 1;
+    }
+    n -= p.lines;
+    pos += p.len;
+  }
+  return _size;  // not reached if block totals are correct
+}
+
+std::size_t TextBuffer::lineOf(std::size_t pos) const
+{
+  if (pos >= _size) { return _lineCount; }
+
+  const Location loc = find(pos);
+  const Block& blk = _blocks[loc.block];
+  std::size_t line = blk.line;
+  for (std::size_t i = 0; i < loc.piece; ++i) { line += blk.pieces[i].lines; }
+  const Piece& p = blk.pieces[loc.piece];
+  return line + makePiece(p.start, loc.offset, p.added).lines;
+}
+
+std::size_t TextBuffer::prevChar(std::size_t pos) const
+{
+  if (pos == 0) { return 0; }
+  pos = std::min(pos, _size) - 1;
+  while (pos > 0 && (at(pos) & 0xC0) == 0x80) { --pos; }
+  return pos;
+}
+
+std::size_t TextBuffer::nextChar(std::size_t pos) const
+{
+  if (pos >= _size) { return _size; }
+  ++pos;
+  while (pos < _size && (at(pos) & 0xC0) == 0x80) { ++pos; }
+  return pos;
+}
+
+std::size_t TextBuffer::pieces() const
+{
+  std::size_t n = 0;
+  for (const Block& b : _blocks) { n += b.pieces.size(); }
+  return n;
+}
+
+TextBuffer::Piece TextBuffer::makePiece(
+  std::size_t start, std::size_t len, bool added) const
+{
+  const std::vector<std::size_t>& nl = added ? _addedNL : _originalNL;
+  const auto first = std::lower_bound(nl.begin(), nl.end(), start);
+  const auto last = std::lower_bound(first, nl.end(), start + len);
+  return {start, len, std::size_t(last - first), added};
+}
+
+TextBuffer::Location TextBuffer::find(std::size_t pos) const
+{
+  if (pos >= _size) {
+    return {_blocks.size() - 1, _blocks.back().pieces.size(), 0};
+  }
+
+  const auto bItr = std::partition_point(
+    _blocks.begin() + 1, _blocks.end(),
+    [pos](const Block& x){ return x.start <= pos; }) - 1;
+  std::size_t i = 0, offset = pos - bItr->start;
+  while (offset >= bItr->pieces[i].len) { offset -= bItr->pieces[i++].len; }
+  return {std::size_t(bItr - _blocks.begin()), i, offset};
+}
+
+void TextBuffer::splitBlock(std::size_t b)
+{
+  // move 2nd half of pieces to new block after b
+  // (cumulative values are set by next updateBlocks() call)
+  std::vector<Piece>& pieces = _blocks[b].pieces;
+  const auto mid = pieces.begin() + std::ptrdiff_t(pieces.size() / 2);
+  Block nb;
+  nb.pieces.assign(mid, pieces.end());
+  pieces.erase(mid, pieces.end());
+  calcTotals(nb);
+  _blocks.insert(_blocks.begin() + std::ptrdiff_t(b) + 1, std::move(nb));
+}
+
+void TextBuffer::calcTotals(Block& blk)
+{
+  blk.size = blk.lines = 0;
+  for (const Piece& p : blk.pieces) {
+    blk.size += p.len;
+    blk.lines += p.lines;
+  }
+}
+
+void TextBuffer::updateBlocks(std::size_t b)
+{
+  calcTotals(_blocks[b]);
+
+  std::size_t start = 0, line = 0;
+  if (b > 0) {
+    const Block& prev = _blocks[b - 1];
+    start = prev.start + prev.size;
+    line = prev.line + prev.lines;
+  }
+  for (; b < _blocks.size(); ++b) {
+    Block& x = _blocks[b];
+    x.start = start;
+    x.line = line;
+    start += x.size;
+    line += x.lines;
+  }
+}
@@ -0,0 +1,105 @@
+//
+// gx/TextBuffer.hh
+// Copyright (C) 2026 Richard Bradley
+//
+// Editable text buffer (piece table w/ incremental line index)
+// - edits don't copy existing text, only inserted text is stored
+// - pieces are grouped in blocks w/ cumulative byte & line counts, so
+//   piece lookup is a binary search & edits only update local pieces
+//   (plus a pass over the block totals)
+// - line starts are found from the '\n' positions of the source buffers
+//   (calculated once as text is added)
+// - positions are byte offsets into UTF-8 text
+//
+
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+namespace gx { class TextBuffer; }
+
+
+class gx::TextBuffer
+{
+ public:
+  TextBuffer() = default;
+  explicit TextBuffer(std::string_view text) { assign(text); }
+
+  // buffer modification
+  void assign(std::string_view text);
+  void clear() { assign({}); }
+  void insert(std::size_t pos, std::string_view text);
+  void erase(std::size_t pos, std::size_t len);
+
+  // buffer access
+  [[nodiscard]] std::size_t size() const { return _size; }
+  [[nodiscard]] bool empty() const { return _size == 0; }
+  [[nodiscard]] char at(std::size_t pos) const;
+  void getText(std::size_t pos, std::size_t len, std::string& out) const;
+    // sets out to text of range (range is clipped to buffer size)
+  [[nodiscard]] std::string text() const;
+
+  [[nodiscard]] std::string_view chunkAt(std::size_t pos) const;
+    // contiguous text from pos to end of its piece (empty at buffer end)
+  [[nodiscard]] std::string_view chunkBefore(std::size_t pos) const;
+    // contiguous text from start of piece up to pos (empty at 0)
+
+  // line access (always at least 1 line)
+  [[nodiscard]] std::size_t lines() const { return _lineCount + 1; }
+  [[nodiscard]] std::size_t lineStart(std::size_t line) const;
+  [[nodiscard]] std::size_t lineEnd(std::size_t line) const {
+    return (line < _lineCount) ? lineStart(line + 1) - 1 : _size; }
+    // position of line's '\n' (or buffer end for last line)
+  [[nodiscard]] std::size_t lineOf(std::size_t pos) const;
+  void getLine(std::size_t line, std::string& out) const {
+    const std::size_t ls = lineStart(line);
+    getText(ls, lineEnd(line) - ls, out); }
+    // sets out to line text (w/o '\n')
+
+  // UTF-8 character stepping
+  [[nodiscard]] std::size_t prevChar(std::size_t pos) const;
+  [[nodiscard]] std::size_t nextChar(std::size_t pos) const;
+
+  [[nodiscard]] std::size_t pieces() const;
+
+ private:
+  static constexpr std::size_t MAX_BLOCK_PIECES = 64;
+
+  struct Piece {
+    std::size_t start;  // start offset in source buffer
+    std::size_t len;
+    std::size_t lines;  // '\n' count
+    bool added;         // source is _added if set, _original otherwise
+  };
+
+  struct Block {
+    std::vector<Piece> pieces;
+    std::size_t size = 0, lines = 0;  // piece totals
+    std::size_t start = 0, line = 0;  // bytes & '\n' count before block
+  };
+
+  struct Location {
+    std::size_t block, piece, offset;
+  };
+
+  std::string _original;         // text from last assign()
+  std::string _added;            // all inserted text (append only)
+  std::vector<std::size_t> _originalNL, _addedNL; // source '\n' positions
+  std::vector<Block> _blocks;
+  std::size_t _size = 0;
+  std::size_t _lineCount = 0;    // total '\n' count
+
+  [[nodiscard]] const char* source(const Piece& p) const {
+    return (p.added ? _added.data() : _original.data()) + p.start; }
+  [[nodiscard]] Piece makePiece(
+    std::size_t start, std::size_t len, bool added) const;
+  [[nodiscard]] Location find(std::size_t pos) const;
+    // returns location of pos (pos at buffer end is 1 past the last piece
+    // of the last block, buffer must not be empty)
+  void splitBlock(std::size_t b);
+  static void calcTotals(Block& blk);
+  void updateBlocks(std::size_t b);
+    // recalc block totals for b & cumulative values for b & later blocks
+};
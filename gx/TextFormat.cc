@@ -52,11 +52,8 @@ gx::TextProperties TextFormat::calcProperties(std::string_view text) const
         }
       }
 
-      const Glyph* g = font->findGlyph(ch);
-      if (!g) {
-        g = font->findGlyph(font->unknownCode());
-        GX_ASSERT(g != nullptr);
-      }
+      const Glyph* g = font->findGlyphOrUnknown(ch);
+      GX_ASSERT(g != nullptr);
 
       len += g->advX + glyphSpacing;
     }
@@ -143,11 +140,8 @@ int TextFormat::calcRegions(
         }
       }
 
-      const Glyph* g = font->findGlyph(ch);
-      if (!g) {
-        g = font->findGlyph(font->unknownCode());
-        GX_ASSERT(g != nullptr);
-      }
+      const Glyph* g = font->findGlyphOrUnknown(ch);
+      GX_ASSERT(g != nullptr);
 
       len += g->advX + glyphSpacing;
     }
@@ -197,11 +191,8 @@ std::string_view TextFormat::fitText(
       }
     }
 
-    const Glyph* g = font->findGlyph(ch);
-    if (!g) {
-      g = font->findGlyph(font->unknownCode());
-      GX_ASSERT(g != nullptr);
-    }
+    const Glyph* g = font->findGlyphOrUnknown(ch);
+    GX_ASSERT(g != nullptr);
 
     const float len = g->advX + glyphSpacing;
     if ((width + len) > maxWidth) { return text.substr(0, itr.pos()); }
@@ -0,0 +1,250 @@
+//
+// gx/TextLayoutCache.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "TextLayoutCache.hh"
+#include "TextMetaState.hh"
+#include "StringUtil.hh"
+#include "Font.hh"
+#include "Unicode.hh"
+#include "IDRegion.hh"
+#include "Time.hh"
+#include "Assert.hh"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+using namespace gx;
+
+
+[[nodiscard]] static uint64_t hashMix(uint64_t h, uint64_t v)
+{
+  return h ^ (v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+}
+
+void TextLayoutCache::clear()
+{
+  _entries.clear();
+  _index.clear();
+}
+
+gx::TextProperties TextLayoutCache::calcProperties(
+  const TextFormat& tf, std::string_view text)
+{
+  if (text.empty()) { return {}; }
+
+  const Entry& e = get(tf, text);
+  const float lh = float(tf.font->size()) + tf.lineSpacing;
+  return {e.width, std::max((lh * float(e.lines)) - tf.lineSpacing, 0.0f),
+          e.idCount};
+}
+
+int TextLayoutCache::calcRegions(
+  const TextFormat& tf, Vec2 pos, Align align, std::string_view text,
+  IDRegionList& regions)
+{
+  if (text.empty()) { return 0; }
+
+  const Entry& e = get(tf, text);
+  const Font& f = *tf.font;
+  const float fs = float(f.size());
+  const float lh = fs + tf.lineSpacing;
+  const Align h_align = hAlign(align);
+  const Align v_align = vAlign(align);
+
+  pos -= tf.glyphY * f.ymax();
+  if (v_align == Align::top) {
+    pos += tf.advY * f.ymax();
+  } else if (v_align == Align::bottom) {
+    pos += tf.advY * (f.ymin() - (lh * float(e.lines - 1)));
+  } else if (v_align == Align::vcenter) {
+    pos += tf.advY * ((f.ymax() - (lh * float(e.lines - 1))) * .5f);
+  }
+
+  for (const Region& r : e.regions) {
+    const float w = e.lineWidths[r.line];
+    const float offset = (h_align == Align::left) ? 0.0f
+      : ((h_align == Align::right) ? w : (w * .5f));
+    const Vec2 lp = pos + (tf.advY * (lh * float(r.line)));
+    regions.add(r.id, lp + (tf.advX * (r.x0 - offset)),
+                lp + (tf.advX * (r.x1 - offset)) + (tf.advY * fs));
+  }
+  return int(e.regions.size());
+}
+
+const TextLayoutCache::Entry& TextLayoutCache::get(
+  const TextFormat& tf, std::string_view text)
+{
+  GX_ASSERT(tf.font != nullptr);
+  const Key key{tf.font->serial(), tf.glyphSpacing, tf.tabWidth,
+                tf.startTag, tf.endTag, tf.ignoreColor};
+
+  uint64_t hash = hashStr(text);
+  hash = hashMix(hash, key.fontSerial);
+  hash = hashMix(hash, std::bit_cast<uint32_t>(key.glyphSpacing));
+  hash = hashMix(hash, std::bit_cast<uint32_t>(key.tabWidth));
+  hash = hashMix(hash, (uint64_t(uint32_t(key.startTag)) << 32)
+                 | uint64_t(uint32_t(key.endTag)));
+  hash = hashMix(hash, key.ignoreColor ? 1 : 0);
+
+  Entry* e = nullptr;
+  const auto itr = _index.find(hash);
+  if (itr != _index.end()) {
+    e = &_entries[itr->second];
+    if (e->key == key && e->text == text) {
+      e->lastUse = ++_useCount;
+      ++_hits;
+      _maxSavedNsec += e->layoutNsec;
+      return *e;
+    }
+    // hash collision, entry is replaced
+  } else if (_entries.size() < _maxEntries || _entries.empty()) {
+    _index[hash] = uint32_t(_entries.size());
+    e = &_entries.emplace_back();
+  } else {
+    // replace least recently used entry
+    e = &_entries[0];
+    for (Entry& x : _entries) { if (x.lastUse < e->lastUse) { e = &x; } }
+    _index.erase(e->hash);
+    _index[hash] = uint32_t(e - _entries.data());
+  }
+
+  ++_misses;
+  const int64_t t0 = nsecTime();
+  e->key = key;
+  e->text = text;
+  e->hash = hash;
+  e->lastUse = ++_useCount;
+  layout(*e, tf);
+  e->layoutNsec = nsecTime() - t0;
+  _layoutNsec += e->layoutNsec;
+  return *e;
+}
+
+void TextLayoutCache::layout(Entry& e, const TextFormat& tf)
+{
+  // same glyph/tag processing as DrawContext2D::text() (w/o selected ID
+  // highlighting) & TextFormat::calcProperties()/calcRegions()
+  const Font& f = *tf.font;
+  const Glyph* ulGlyph = f.findGlyph('_');
+  e.items.clear();
+  e.lineWidths.clear();
+  e.regions.clear();
+  e.width = 0;
+  e.lines = 0;
+  e.idCount = 0;
+
+  TextMetaState ts;
+  int64_t activeID = 0;
+  float ulStart = 0, ulLen = 0;
+  bool underline = false, colorChanged = true;
+
+  for (LineIterator lineItr{e.text}; lineItr; ++lineItr, ++e.lines) {
+    const auto line = *lineItr;
+    if (line.empty()) { e.lineWidths.push_back(0); continue; }
+
+    const uint32_t ln = uint32_t(e.lines);
+    float regionStart = 0, len = 0;
+    enum { UL_noop, UL_start, UL_end} ulOp = UL_noop;
+    for (UTF8Iterator itr{line}; itr; ++itr) {
+      if (ulOp == UL_end) {
+        if (ulGlyph) {
+          e.items.push_back(
+            {ITEM_underline, ln, 0, ulStart, ulLen - tf.glyphSpacing, ulGlyph});
+        }
+        underline = false;
+        ulOp = UL_noop;
+      }
+      if (colorChanged) {
+        e.items.push_back({ITEM_setColor, ln, 0, 0, 0, nullptr});
+        colorChanged = false;
+      }
+
+      int ch = *itr;
+      if (ch == tf.startTag && tf.startTag != 0) {
+        const std::size_t startPos = itr.nextPos();
+        const std::size_t endPos = findUTF8(line, tf.endTag, startPos);
+        if (endPos != std::string_view::npos) {
+          const auto tag = line.substr(startPos, endPos - startPos);
+          const auto tagType = ts.parseTag(tag);
+          if (tagType != TAG_unknown) {
+            if (tagType == TAG_color) {
+              if (!tf.ignoreColor) {
+                const bool init = (ts.colorCount() == 0);
+                e.items.push_back({init ? ITEM_initColor : ITEM_color, ln,
+                                   ts.color(), 0, 0, nullptr});
+                colorChanged = true;
+              }
+            } else if (tagType == TAG_underline) {
+              if (!underline && ts.underline()) {
+                ulOp = UL_start;
+              } else if (underline && !ts.underline()) {
+                ulOp = UL_end;
+              }
+            } else if (tagType == TAG_id) {
+              const int64_t id = ts.activeID();
+              if (id != 0) { ++e.idCount; }
+              if (activeID != 0) {
+                // end region
+                e.regions.push_back({activeID, ln, regionStart, len});
+              }
+              if (id != 0) {
+                // start region
+                regionStart = len;
+              }
+              activeID = id;
+            }
+
+            itr.setPos(endPos);
+            continue;
+          }
+        }
+      } else if (ch == '\t') {
+        if (tf.tabWidth <= 0) {
+          ch = ' ';
+        } else {
+          len = (std::floor(len / tf.tabWidth) + 1.0f) * tf.tabWidth;
+          continue;
+        }
+      }
+
+      const Glyph* g = f.findGlyphOrUnknown(ch);
+      GX_ASSERT(g != nullptr);
+
+      if (!g->empty()) {
+        e.items.push_back({ITEM_glyph, ln, 0, len, 0, g});
+      }
+
+      if (ulOp == UL_start) {
+        ulStart = len; ulLen = 0;
+        underline = true; ulOp = UL_noop;
+      }
+
+      const float adv = g->advX + tf.glyphSpacing;
+      if (underline) { ulLen += adv; }
+      len += adv;
+    }
+
+    // finish end-of-line underline
+    if (underline) {
+      if (ulGlyph) {
+        e.items.push_back(
+          {ITEM_underline, ln, 0, ulStart, ulLen - tf.glyphSpacing, ulGlyph});
+      }
+      underline = false;
+    }
+    if (colorChanged) {
+      e.items.push_back({ITEM_setColor, ln, 0, 0, 0, nullptr});
+      colorChanged = false;
+    }
+
+    if (activeID != 0) {
+      // end region
+      e.regions.push_back({activeID, ln, regionStart, len});
+    }
+
+    const float w = std::max(len - tf.glyphSpacing, 0.0f);
+    e.lineWidths.push_back(w);
+    e.width = std::max(e.width, w);
+  }
+}
@@ -0,0 +1,121 @@
+//
+// gx/TextLayoutCache.hh
+// Copyright (C) 2026 Richard Bradley
+//
+// LRU cache of text layouts for DrawContext2D::text() & TextFormat
+// property/region calculations
+// - entries are keyed by font serial, TextFormat spacing/tag values &
+//   text, so unchanged text skips UTF-8 decoding, tag parsing & glyph
+//   lookup
+// - glyph positions are stored along each line, TextFormat direction
+//   vectors, line spacing & alignment are applied when drawn
+// - entries of a destroyed or changed font are never matched (font serial
+//   changes), so they are only removed by LRU replacement or clear()
+//
+
+#pragma once
+#include "TextFormat.hh"
+#include "Color.hh"
+#include "Types.hh"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+
+class gx::TextLayoutCache
+{
+ public:
+  static constexpr std::size_t DEFAULT_SIZE = 1024;
+
+  explicit TextLayoutCache(std::size_t maxEntries = DEFAULT_SIZE)
+    : _maxEntries{maxEntries} { }
+
+  void clear();
+    // remove all entries (stats are kept, see resetStats())
+
+  [[nodiscard]] TextProperties calcProperties(
+    const TextFormat& tf, std::string_view text);
+  int calcRegions(const TextFormat& tf, Vec2 pos, Align align,
+                  std::string_view text, IDRegionList& regions);
+    // same results as TextFormat functions (using cached layout)
+
+  [[nodiscard]] std::size_t size() const { return _entries.size(); }
+  [[nodiscard]] std::size_t maxEntries() const { return _maxEntries; }
+
+  // stats
+  [[nodiscard]] int64_t hits() const { return _hits; }
+  [[nodiscard]] int64_t misses() const { return _misses; }
+  [[nodiscard]] double hitRate() const {
+    const int64_t n = _hits + _misses;
+    return (n > 0) ? double(_hits) / double(n) : 0.0; }
+  [[nodiscard]] int64_t layoutNsec() const { return _layoutNsec; }
+    // total time spent creating layouts for cache misses
+  [[nodiscard]] int64_t maxSavedNsec() const { return _maxSavedNsec; }
+    // upper bound of layout time saved by cache hits (sum of each hit
+    // entry's creation time, which includes first use costs like lazy
+    // glyph loading & allocation, hit lookup time isn't subtracted)
+  void resetStats() {
+    _hits = 0; _misses = 0; _layoutNsec = 0; _maxSavedNsec = 0; }
+
+ private:
+  friend class DrawContext2D;
+
+  struct Key {
+    uint64_t fontSerial;  // Font::serial() (font address can be reused)
+    float glyphSpacing, tabWidth;
+    int32_t startTag, endTag;
+    bool ignoreColor;
+
+    [[nodiscard]] bool operator==(const Key&) const = default;
+  };
+
+  enum ItemType : uint8_t {
+    ITEM_glyph,      // draw glyph at x
+    ITEM_underline,  // draw glyph from x stretched to width
+    ITEM_color,      // set color
+    ITEM_initColor,  // restore color from start of text() call
+    ITEM_setColor    // output current color to DrawList
+  };
+
+  struct Item {
+    ItemType type;
+    uint32_t line;
+    RGBA8 color;
+    float x, width;
+    const Glyph* glyph;
+  };
+
+  struct Region {
+    int64_t id;
+    uint32_t line;
+    float x0, x1;
+  };
+
+  struct Entry {
+    Key key;
+    std::string text;
+    uint64_t hash;
+    uint64_t lastUse;
+    std::vector<Item> items;         // draw operations in order
+    std::vector<float> lineWidths;
+    std::vector<Region> regions;     // ID tag regions
+    float width;
+    int lines, idCount;
+    int64_t layoutNsec;              // time to create layout
+  };
+
+  std::vector<Entry> _entries;
+  std::unordered_map<uint64_t,uint32_t> _index; // hash -> entry
+  std::size_t _maxEntries;
+  uint64_t _useCount = 0;
+  int64_t _hits = 0, _misses = 0;
+  int64_t _layoutNsec = 0, _maxSavedNsec = 0;
+
+  [[nodiscard]] const Entry& get(const TextFormat& tf, std::string_view text);
+    // returns cached layout (created if not in cache, text not empty)
+
+  static void layout(Entry& e, const TextFormat& tf);
+};
@@ -16,6 +16,12 @@ namespace gx {
       steady_clock::now().time_since_epoch()).count();
   }
 
+  [[nodiscard]] inline int64_t nsecTime() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+      steady_clock::now().time_since_epoch()).count();
+  }
+
   [[nodiscard]] inline int64_t secTime() {
     using namespace std::chrono;
     return duration_cast<seconds>(
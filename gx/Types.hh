@@ -16,21 +16,26 @@ namespace gx {
   using Mat4 = Matrix4x4<float,ROW_MAJOR>;
 
   // forward declare major types
+  class AtlasPacker;
   class Camera;
   class DrawContext2D;
   class DrawContext3D;
   class DrawList;
   struct EventState;
   class Font;
+  class FontAtlas;
   struct Glyph;
   class IDRegionList;
   class Image;
   class Logger;
+  class Path;
   class RandomSequence;
   struct Rect;
   class Renderer;
+  class ShapeCache;
   struct Style;
   struct TextFormat;
+  class TextLayoutCache;
   class TextMetaState;
   class TextureHandle;
   struct TextureParams;
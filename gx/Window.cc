@@ -73,13 +73,18 @@ const gx::EventState& Window::eventState() const {
   return _impl->_eventState; }
 
 int Window::pollEvents()
+{
+  return waitEvents(0);
+}
+
+int Window::waitEvents(int64_t timeoutUsec)
 {
   const std::lock_guard lg{allImplsMutex};
   for (auto w : allImpls) {
     w->resetEventState();
   }
 
-  WindowImpl::pollEvents();
+  WindowImpl::waitEvents(timeoutUsec);
 
   int e = 0;
   _lastPollTime = usecTime();
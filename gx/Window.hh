@@ -95,6 +95,11 @@ class gx::Window
     // updates event state for all windows, returns combined event mask
     // (each window should be checked for events if returned value is non-zero)
 
+  static int waitEvents(int64_t timeoutUsec = -1);
+    // same as pollEvents() but sleeps until an event is received or
+    // timeout is reached (timeout < 0 waits indefinitely)
+    // (use instead of pollEvents() to avoid busy looping when idle)
+
   [[nodiscard]] static int64_t lastPollTime() { return _lastPollTime; }
     // time of last pollEvents()
     // (in microseconds since first window open)
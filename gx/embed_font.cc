@@ -0,0 +1,149 @@
+//
+// gx/embed_font.cc
+// Copyright (C) 2026 Richard Bradley
+//
+// command line tool to generate source with a prerendered font
+// (glyph metrics & prepacked atlas for each font size) for loading with
+// Font::loadFromData() w/o any runtime glyph rendering
+//
+
+#include "Font.hh"
+#include "Image.hh"
+#include "CmdLineParser.hh"
+#include "Print.hh"
+#include <charconv>
+#include <string>
+#include <vector>
+
+// put in global namespace for convenience
+using gx::print, gx::println, gx::println_err;
+
+
+constexpr int ROW_SIZE = 32;
+constexpr int MAX_ATLAS_SIZE = 16384;
+constexpr const char* DEFAULT_INCLUDE = "gx/Font.hh";
+
+
+int showUsage(const char* const* argv)
+{
+  println("Usage: ", argv[0], " [options] <font file> <name> <size>...");
+  println("Generates 'const gx::FontStaticData <name><size>' for each size");
+  println("Options:");
+  println("  -i,--include=[]  Font.hh include path (default ",
+          DEFAULT_INCLUDE, ")");
+  println("  -m,--maxsize=[]  Max atlas width/height (default ",
+          MAX_ATLAS_SIZE, ")");
+  println("  --sdf            Signed distance field glyphs");
+  println("  -h,--help        Show usage");
+  return 0;
+}
+
+int errorUsage(const char* const* argv)
+{
+  println_err("Try '", argv[0], " --help' for more information.");
+  return -1;
+}
+
+std::string floatStr(float v)
+{
+  // shortest exact value as float literal
+  char buffer[32];
+  const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), v);
+  std::string s{buffer, end};
+  if (s.find_first_of(".e") == std::string::npos) { s += ".0"; }
+  return s += 'f';
+}
+
+bool outputFont(const std::string& file, const std::string& name, int size,
+                int maxSize, bool sdf)
+{
+  gx::Font fnt{size};
+  fnt.setSDF(sdf);
+  if (!fnt.load(file)) {
+    println_err("ERROR: can't load font '", file, "' (size ", size, ")");
+    return false;
+  }
+
+  std::vector<gx::AtlasPacker::Item> items;
+  gx::Image img;
+  if (!fnt.packAtlas(maxSize, items, img)) {
+    println_err("ERROR: font glyphs don't fit in max atlas size ", maxSize);
+    return false;
+  }
+
+  const std::string var = name + std::to_string(size);
+  println("\n// size ", size, " (", fnt.glyphs().size(), " glyphs, ",
+          img.width(), "x", img.height(), " atlas)");
+  println("static const unsigned char ", var, "Atlas[] = {");
+  const uint8_t* data = img.data();
+  for (std::size_t i = 0; i < img.size(); ++i) {
+    print(uint32_t{data[i]}, ",");
+    if ((i % ROW_SIZE) == (ROW_SIZE - 1)) { println(); }
+  }
+  println("};\n");
+
+  println("static const gx::GlyphStaticData ", var, "Glyphs[] = {");
+  auto item = items.cbegin();
+  for (const gx::Glyph& g : fnt.glyphs()) {
+    const gx::AtlasPacker::Item& i = *item++;
+    const bool e = g.empty();
+    println("  {", g.code, ",", g.width, ",", g.height, ",",
+            floatStr(g.left), ",", floatStr(g.top), ",", floatStr(g.advX),
+            ",", floatStr(g.advY), ",nullptr,", e ? 0 : i.x, ",",
+            e ? 0 : i.y, "},");
+  }
+  println("};\n");
+
+  println("extern const gx::FontStaticData ", var, ";");
+  println("const gx::FontStaticData ", var, "{\n  ", size, ", ", var,
+          "Glyphs, ", fnt.glyphs().size(), ", ", var, "Atlas, ",
+          img.width(), ", ", img.height(), sdf ? ", true};" : "};");
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  std::string file, name, include = DEFAULT_INCLUDE;
+  std::vector<int> sizes;
+  int maxSize = MAX_ATLAS_SIZE;
+  bool sdf = false;
+
+  for (gx::CmdLineParser p{argc, argv}; p; ++p) {
+    if (p.option()) {
+      if (p.option('h',"help")) {
+        return showUsage(argv);
+      } else if (p.option('i',"include", include)) {
+        // include path set
+      } else if (p.option('m',"maxsize", maxSize)) {
+        if (maxSize <= 0) { maxSize = MAX_ATLAS_SIZE; }
+      } else if (p.option(0,"sdf")) {
+        sdf = true;
+      } else {
+        println_err("ERROR: bad option '", p.arg(), "'");
+        return errorUsage(argv);
+      }
+    } else if (file.empty()) {
+      p.get(file);
+    } else if (name.empty()) {
+      p.get(name);
+    } else {
+      int s = 0;
+      if (!p.get(s) || s <= 0) {
+        println_err("ERROR: bad font size '", p.arg(), "'");
+        return errorUsage(argv);
+      }
+      sizes.push_back(s);
+    }
+  }
+
+  if (file.empty() || name.empty() || sizes.empty()) {
+    return errorUsage(argv);
+  }
+
+  println("// generated from '", file, "'\n");
+  println("#include \"", include, "\"");
+  for (int s : sizes) {
+    if (!outputFont(file, name, s, maxSize, sdf)) { return -1; }
+  }
+  return 0;
+}
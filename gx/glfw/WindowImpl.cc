@@ -357,11 +357,16 @@ void WindowImpl::focus()
   }
 }
 
-void WindowImpl::pollEvents()
+void WindowImpl::waitEvents(int64_t timeoutUsec)
 {
   GX_ASSERT(isMainThread());
-  glfwPollEvents();
-    // callbacks will set event values
+  if (timeoutUsec < 0) {
+    glfwWaitEvents();
+  } else if (timeoutUsec == 0) {
+    glfwPollEvents();
+  } else {
+    glfwWaitEventsTimeout(double(timeoutUsec) / 1000000.0);
+  }
 }
 
 void WindowImpl::showWindow()
@@ -35,7 +35,7 @@ class gx::WindowImpl
   bool open(int flags);
   void focus();
 
-  static void pollEvents();
+  static void waitEvents(int64_t timeoutUsec);
   void resetEventState();
 
   std::unique_ptr<Renderer> _renderer;
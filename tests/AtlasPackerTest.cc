@@ -0,0 +1,106 @@
+//
+// AtlasPackerTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "gx/AtlasPacker.hh"
+#include <vector>
+#include <cassert>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+std::vector<AtlasPacker::Item> makeItems(int count)
+{
+  // mix of small items & a few tall/wide ones
+  std::vector<AtlasPacker::Item> items;
+  unsigned int r = 12345;
+  for (int i = 0; i < count; ++i) {
+    r = (r * 1103515245u) + 12345u;
+    const int w = int((r >> 16) % 24u) + 1;
+    const int h = int((r >> 8) % 24u) + 1;
+    items.push_back({(i % 50 == 0) ? w * 4 : w, (i % 37 == 0) ? h * 4 : h});
+  }
+  items.push_back({0, 10});  // empty items use no space
+  items.push_back({10, 0});
+  return items;
+}
+
+bool validPacking(const AtlasPacker& p,
+                  const std::vector<AtlasPacker::Item>& items)
+{
+  const int pad = p.padding();
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    const AtlasPacker::Item& a = items[i];
+    if (a.width == 0 || a.height == 0) { continue; }
+    if (!a.packed() || a.x < pad || a.y < pad
+        || (a.x + a.width + pad) > p.width()
+        || (a.y + a.height + pad) > p.height()) { return false; }
+
+    for (std::size_t j = i + 1; j < items.size(); ++j) {
+      const AtlasPacker::Item& b = items[j];
+      if (b.width == 0 || b.height == 0) { continue; }
+      if ((a.x < (b.x + b.width + pad)) && (b.x < (a.x + a.width + pad))
+          && (a.y < (b.y + b.height + pad)) && (b.y < (a.y + a.height + pad))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void test_insert()
+{
+  AtlasPacker p{64, 64, 1};
+  int x, y;
+  assert(p.insert(62, 10, x, y) && x == 1 && y == 1);
+  assert(p.insert(30, 20, x, y) && x == 1 && y == 12);
+  assert(p.insert(31, 10, x, y) && x == 32 && y == 12);
+  assert(p.usedHeight() == 33);
+  assert(!p.insert(63, 10, x, y));  // too wide w/ padding
+  assert(!p.insert(10, 42, x, y));  // too tall for space left
+
+  p.init(64, 64);
+  assert(p.insert(64, 64, x, y) && x == 0 && y == 0);
+  assert(p.efficiency() == 1.0f);
+}
+
+void test_pack()
+{
+  std::vector<AtlasPacker::Item> items = makeItems(500);
+  AtlasPacker p{256, 1024, 2};
+  assert(p.pack(items));
+  assert(validPacking(p, items));
+
+  // items that don't fit are marked as unpacked
+  std::vector<AtlasPacker::Item> big = makeItems(500);
+  AtlasPacker small{128, 128, 0};
+  assert(!small.pack(big));
+  int packed = 0;
+  for (const auto& i : big) { packed += i.packed() ? 1 : 0; }
+  assert(packed > 0 && packed < int(big.size()));
+}
+
+void test_packAll()
+{
+  std::vector<AtlasPacker::Item> items = makeItems(2000);
+  AtlasPacker p;
+  assert(p.packAll(items, 4096, 1));
+  assert(validPacking(p, items));
+  assert((p.width() % 16) == 0 && (p.height() % 16) == 0);
+  assert(p.height() <= p.width());
+  assert(p.efficiency() > .75f);
+
+  assert(!p.packAll(items, 128, 1));
+}
+
+int main(int argc, char** argv)
+{
+  test_insert();
+  test_pack();
+  test_packAll();
+  return 0;
+}
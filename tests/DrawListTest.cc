@@ -0,0 +1,330 @@
+//
+// DrawListTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "gx/DrawList.hh"
+#include "gx/DrawContext2D.hh"
+#include "gx/ShapeCache.hh"
+#include "gx/TextLayoutCache.hh"
+#include "gx/TextFormat.hh"
+#include "gx/Font.hh"
+#include "gx/IDRegion.hh"
+#include "gx/Style.hh"
+#include <string>
+#include <cassert>
+#include <initializer_list>
+#include <cmath>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+[[nodiscard]] std::string cmdFormat(const Value* d, const Value* end)
+{
+  // value types of command at d ('u' exact value, 'f' position/float),
+  // empty for unknown command
+  auto rep = [](int n, const char* s) {
+    std::string x; for (int i = 0; i < n; ++i) { x += s; } return x; };
+  const uint32_t n = (end - d > 1) ? d[1].uval : 0;
+  switch (d->uval) {
+    case CMD_noop:         return "u";
+    case CMD_framebuffer:  return "uu";
+    case CMD_viewport:     return "uuuuu";
+    case CMD_viewportFull: return "u";
+    case CMD_color:        return "uu";
+    case CMD_texture:      return "uu";
+    case CMD_normal:       return "uu";
+    case CMD_lineWidth:    return "uf";
+    case CMD_modColor:     return "uu";
+    case CMD_capabilities: return "uu";
+    case CMD_camera:       return "u" + rep(32, "f");
+    case CMD_light:        return "u" + rep(9, "f");
+    case CMD_clearView:    return "uu";
+    case CMD_line2:        return "u" + rep(2, "ff");
+    case CMD_line2C:       return "u" + rep(2, "ffu");
+    case CMD_lineStart2:   return "uff";
+    case CMD_lineTo2:      return "uff";
+    case CMD_lineStart2C:  return "uffu";
+    case CMD_lineTo2C:     return "uffu";
+    case CMD_polyline2:    return "uu" + rep(int(n), "ff");
+    case CMD_polyline2C:   return "uu" + rep(int(n), "ffu");
+    case CMD_triangle2:    return "u" + rep(3, "ff");
+    case CMD_triangle2T:   return "u" + rep(3, "ffff");
+    case CMD_triangle2C:   return "u" + rep(3, "ffu");
+    case CMD_triangle2TC:  return "u" + rep(3, "ffffu");
+    case CMD_quad2:        return "u" + rep(4, "ff");
+    case CMD_quad2T:       return "u" + rep(4, "ffff");
+    case CMD_quad2C:       return "u" + rep(4, "ffu");
+    case CMD_quad2TC:      return "u" + rep(4, "ffffu");
+    case CMD_rectangle:    return "u" + rep(2, "ff");
+    case CMD_rectangleT:   return "u" + rep(2, "ffff");
+    case CMD_shapeRectangle:  return "uffffff";
+    case CMD_shapeRectangleC: return "uffffffuuuu";
+    case CMD_shapeTriangle2:  return "uffff" + rep(3, "ff");
+    case CMD_shapeTriangle2C: return "uffff" + rep(3, "ffu");
+    case CMD_line3:        return "u" + rep(2, "fff");
+    case CMD_line3C:       return "u" + rep(2, "fffu");
+    case CMD_lineStart3:   return "ufff";
+    case CMD_lineTo3:      return "ufff";
+    case CMD_lineStart3C:  return "ufffu";
+    case CMD_lineTo3C:     return "ufffu";
+    case CMD_triangle3:    return "u" + rep(3, "fff");
+    case CMD_triangle3T:   return "u" + rep(3, "fffff");
+    case CMD_triangle3C:   return "u" + rep(3, "fffu");
+    case CMD_triangle3TC:  return "u" + rep(3, "fffffu");
+    case CMD_quad3:        return "u" + rep(4, "fff");
+    case CMD_quad3T:       return "u" + rep(4, "fffff");
+    case CMD_quad3C:       return "u" + rep(4, "fffu");
+    case CMD_quad3TC:      return "u" + rep(4, "fffffu");
+    default:               return {};
+  }
+}
+
+bool sameList(const DrawList& a, const DrawList& b)
+{
+  // commands/colors/counts must match exactly, positions can have
+  // rounding error
+  if (a.size() != b.size()) { return false; }
+  const Value* da = a.data();
+  const Value* db = b.data();
+  const Value* end = da + a.size();
+  while (da < end) {
+    if (da->uval != db->uval) { return false; }
+    const std::string fmt = cmdFormat(da, end);
+    if (fmt.empty() || std::size_t(end - da) < fmt.size()) { return false; }
+    for (char t : fmt) {
+      if (da->uval != db->uval
+          && (t == 'u' || !(std::abs(da->fval - db->fval) <= .001f))) {
+        return false;
+      }
+      ++da; ++db;
+    }
+  }
+  return true;
+}
+
+void test_sameList()
+{
+  // positions can have rounding error, colors/commands can't
+  DrawList a, b, c, d;
+  a.color(0xff0000ff);
+  a.rectangle({0,0}, {10,10});
+  b.color(0xff0000ff);
+  b.rectangle({0,0}, {10.0001f,10});
+  c.color(0xff0000fe);
+  c.rectangle({0,0}, {10,10});
+  d.color(0xff0000ff);
+  d.line2({0,0}, {10,10});
+  assert(sameList(a, b));
+  assert(!sameList(a, c));
+  assert(!sameList(a, d));
+
+  DrawList e, f;
+  e.lineWidth(1.0f);
+  e.quad2C({0,0,1}, {1,0,2}, {0,1,3}, {1,1,4});
+  f.lineWidth(1.0001f);
+  f.quad2C({0,0,1}, {1,0,2}, {0,1,3}, {1,1,5});
+  assert(!sameList(e, f));
+}
+
+void test_appendOffset()
+{
+  DrawList src;
+  src.color(0xff0000ff);
+  src.triangle2({0,0}, {10,0}, {0,10});
+  src.quad2C({0,0,1}, {1,0,2}, {0,1,3}, {1,1,4});
+  src.shapeRectangle({0,0}, {10,10}, 2, 1);
+  src.line3({1,2,3}, {4,5,6});
+
+  DrawList dl;
+  dl.append({src.data(), src.size()}, {100,200});
+
+  DrawList expected;
+  expected.color(0xff0000ff);
+  expected.triangle2({100,200}, {110,200}, {100,210});
+  expected.quad2C({100,200,1}, {101,200,2}, {100,201,3}, {101,201,4});
+  expected.shapeRectangle({100,200}, {110,210}, 2, 1);
+  expected.line3({1,2,3}, {4,5,6});
+  assert(sameList(dl, expected));
+}
+
+void drawShapes(DrawContext2D& dc, const Style& s1, const Style& s2)
+{
+  for (int i = 0; i < 10; ++i) {
+    const float x = float(i * 37), y = float(i * 11);
+    dc.shape({x, y, 80, 24}, s1);
+    dc.shape({x, y + 30, 80, 24}, s2);
+    dc.rectangle({x, y, 5, 5}); // uses color state left by shape()
+    dc.shape({x, y + 60, 40 + float(i), 24}, s1);
+  }
+}
+
+void test_shapeCache()
+{
+  Style s1;
+  s1.fillColor = packRGBA8(.2f, .2f, .6f, 1.0f);
+  s1.edgeColor = packRGBA8(.8f, .8f, .8f, 1.0f);
+  s1.cornerRadius = 6;
+  s1.cornerSegments = 4;
+
+  Style s2 = s1;
+  s2.fill = Style::vgradient;
+  s2.fillColor2 = packRGBA8(.1f, .1f, .1f, 1.0f);
+  s2.edge = Style::underline_2px;
+
+  DrawList dl1, dl2;
+  DrawContext2D dc1{dl1}, dc2{dl2};
+  ShapeCache cache{8};
+  dc2.shapeCache(&cache);
+
+  drawShapes(dc1, s1, s2);
+  drawShapes(dc2, s1, s2);
+  assert(sameList(dl1, dl2));
+  assert(cache.size() == 8);
+  assert(cache.hits() > 0);
+
+  // sdf shapes are cached separately
+  dc1.sdfShapes(true);
+  dc2.sdfShapes(true);
+  drawShapes(dc1, s1, s2);
+  drawShapes(dc2, s1, s2);
+  assert(sameList(dl1, dl2));
+}
+
+constexpr const char* TEXTS[] = {
+  "plain text",
+  "<color=red>red</color> & <ul>underlined</ul> text\n\nline\t3",
+  "<ul>open <color=#00ff00>underline\n<id=5>id</id> <id=7>text</id> end",
+  "\t<color=blue><color=white>nested</color></color><bad tag>\n",
+  "hello <id=5>world\nsecond</id> line"};
+
+void drawText(DrawContext2D& dc, const TextFormat& tf)
+{
+  for (const char* txt : TEXTS) {
+    for (Align a : {Align::top_left, Align::center, Align::bottom_right}) {
+      dc.color(0xffffffff);
+      dc.text(tf, {10, 20}, a, txt);
+      dc.hgradient(0, 0xff0000ff, 100, 0xffff0000);
+      dc.text(tf, {30, 60}, a, txt);
+    }
+  }
+}
+
+void test_textCache()
+{
+  Font fnt{16};
+  const uint8_t pixels[8 * 12] = {};
+  for (int ch = ' '; ch <= '~'; ++ch) {
+    const int w = (ch == ' ') ? 0 : 4 + (ch % 5);
+    fnt.addGlyph(ch, w, 12, 1, 11, float(w + 1), 0, pixels, true);
+  }
+
+  TextFormat tf{&fnt, 2.0f, 1.0f, 40.0f};
+  TextFormat rtf = tf;
+  rtf.rotate(.5f);
+  rtf.scale(1.5f);
+
+  DrawList dl1, dl2;
+  DrawContext2D dc1{dl1}, dc2{dl2};
+  TextLayoutCache cache{8};
+  dc2.textCache(&cache);
+
+  for (int i = 0; i < 2; ++i) {
+    drawText(dc1, tf);
+    drawText(dc2, tf);
+    drawText(dc1, rtf);
+    drawText(dc2, rtf);
+  }
+  assert(sameList(dl1, dl2));
+  assert(cache.size() == std::size(TEXTS));
+  assert(cache.misses() == std::size(TEXTS));
+  assert(cache.hitRate() > .9);
+
+  // selected ID highlighting
+  for (bool ul : {false, true}) {
+    dc1.selectedID(7);
+    dc2.selectedID(7);
+    dc1.selectedColor(ul ? 0 : 0xff00ff00);
+    dc2.selectedColor(ul ? 0 : 0xff00ff00);
+    dc1.selectedUnderline(ul);
+    dc2.selectedUnderline(ul);
+    drawText(dc1, tf);
+    drawText(dc2, tf);
+    assert(sameList(dl1, dl2));
+  }
+
+  // properties/regions
+  for (const char* txt : TEXTS) {
+    const TextProperties p1 = tf.calcProperties(txt);
+    const TextProperties p2 = cache.calcProperties(tf, txt);
+    assert(p1.width == p2.width && p1.height == p2.height);
+    assert(p1.idCount == p2.idCount);
+
+    IDRegionList r1, r2;
+    assert(tf.calcRegions({5, 5}, Align::center, txt, r1)
+           == cache.calcRegions(tf, {5, 5}, Align::center, txt, r2));
+    assert(r1.size() == r2.size());
+    for (std::size_t i = 0; i < r1.size(); ++i) {
+      const Rect& a = r1.data()[i].region;
+      const Rect& b = r2.data()[i].region;
+      assert(r1.data()[i].id == r2.data()[i].id);
+      assert(a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h);
+    }
+  }
+
+  // LRU replacement
+  TextLayoutCache small{2};
+  for (int i = 0; i < 2; ++i) {
+    for (const char* txt : TEXTS) { (void)small.calcProperties(tf, txt); }
+  }
+  assert(small.size() == 2);
+  assert(small.hits() == 0);
+}
+
+void test_zeroSegments()
+{
+  // circles/arcs w/o segments draw nothing
+  DrawList dl;
+  DrawContext2D dc{dl};
+  dc.color(0xffffffff);
+  for (int s : {0, -1, -100}) {
+    dc.circle({50, 50}, 20, s);
+    dc.circleSector({50, 50}, 20, 0, 90, s);
+    dc.circleShaded({50, 50}, 20, s, 0xffffffff, 0xff000000);
+    dc.arc({50, 50}, 20, 0, 0, s, 4);
+    dc.arcShaded({50, 50}, 20, 0, 180, s, 4, 0xffffffff, 0xff000000);
+  }
+  assert(dl.size() <= 2); // color only
+}
+
+void test_polylineSmallStep()
+{
+  // x step too small for per column step count, column reduced to first,
+  // min/max & last points (first point is also min)
+  float y[100];
+  for (int i = 0; i < 100; ++i) { y[i] = float(i % 7); }
+  DrawList dl;
+  DrawContext2D dc{dl};
+  dc.color(0xffffffff);
+  dc.polyline(10.5f, 1e-30f, y);
+
+  DrawList expected;
+  expected.color(0xffffffff);
+  const Vec2 pts[] = {{10.5f,y[0]}, {10.5f,6}, {10.5f,y[99]}};
+  expected.polyline2(pts);
+  assert(sameList(dl, expected));
+}
+
+int main(int argc, char** argv)
+{
+  test_sameList();
+  test_appendOffset();
+  test_zeroSegments();
+  test_polylineSmallStep();
+  test_shapeCache();
+  test_textCache();
+  return 0;
+}
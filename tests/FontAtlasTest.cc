@@ -0,0 +1,194 @@
+//
+// FontAtlasTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "gx/FontAtlas.hh"
+#include "gx/Font.hh"
+#include "gx/Image.hh"
+#include <unordered_map>
+#include <cassert>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+// renderer w/ textures stored in memory
+class TestRenderer final : public Renderer
+{
+ public:
+  struct Texture { TextureParams params; Image img; };
+  std::unordered_map<TextureID,Texture> textures;
+
+  explicit TestRenderer(int maxSize) { _maxTextureSize = maxSize; }
+
+  bool init(WindowImpl*) override { return true; }
+  bool setSwapInterval(int) override { return true; }
+  bool setFramebufferSize(int, int) override { return true; }
+  TextureHandle newTexture(const TextureParams& params) override {
+    const TextureID id = newTextureID();
+    textures[id] = {params, Image{params.width, params.height, 1}};
+    return TextureHandle{id};
+  }
+  bool setSubImage(TextureID id, int x, int y, const Image& img) override {
+    textures.at(id).img.stamp(x, y, img);
+    return true;
+  }
+  void draw(std::span<const DrawList*>) override { }
+  void renderFrame(int64_t) override { }
+  void freeTexture(TextureID id) override { textures.erase(id); }
+};
+
+void addGlyphs(Font& f, int first, int count, int size)
+{
+  // solid glyphs w/ code as pixel value
+  uint8_t buf[64 * 64];
+  for (int c = first; c < first + count; ++c) {
+    const int w = 1 + (c % size), h = size;
+    for (int i = 0; i < w * h; ++i) { buf[i] = uint8_t(c); }
+    f.addGlyph(c, w, h, 0, float(h), float(w), 0, buf, true);
+  }
+  f.addGlyph(' ', 0, 0, 0, 0, 4, 0, nullptr, false);
+}
+
+bool validGlyphs(const TestRenderer& tr, const Font& f)
+{
+  // glyph atlas area contains glyph bitmap
+  for (const Glyph& g : f.glyphs()) {
+    if (g.empty()) { continue; }
+    const auto itr = tr.textures.find(g.tex);
+    if (itr == tr.textures.end()) { return false; }
+
+    const Image& img = itr->second.img;
+    const int x = int(g.t0.x * float(img.width()) + .5f);
+    const int y = int(g.t0.y * float(img.height()) + .5f);
+    if (int(g.t1.x * float(img.width()) + .5f) != x + g.width) {
+      return false; }
+    for (int iy = y; iy < y + g.height; ++iy) {
+      for (int ix = x; ix < x + g.width; ++ix) {
+        if (img.data()[(iy * img.width()) + ix] != uint8_t(g.code)) {
+          return false; }
+      }
+    }
+  }
+  return true;
+}
+
+void test_sharedPage()
+{
+  TestRenderer tr{1024};
+  Renderer& ren = tr;
+  Font a{16}, b{32};
+  addGlyphs(a, 'A', 26, 16);
+  addGlyphs(b, 'a', 26, 32);
+  assert(a.makeAtlas(ren) && b.makeAtlas(ren));
+  assert(a.atlas().id() != b.atlas().id());
+
+  FontAtlas atlas;
+  atlas.add(a);
+  atlas.add(b);
+  atlas.add(a);
+  assert(atlas.fonts().size() == 2);
+  assert(atlas.make(ren));
+  assert(atlas.pages() == 1);
+
+  // all glyphs in one texture (previous font atlases freed)
+  const TextureID tid = atlas.page(0).id();
+  assert(a.atlas().id() == tid && b.atlas().id() == tid);
+  assert(a.atlasWidth() == atlas.pageWidth(0));
+  for (const Glyph& g : a.glyphs()) { assert(g.tex == tid); }
+  for (const Glyph& g : b.glyphs()) { assert(g.tex == tid); }
+  assert(tr.textures.size() == 1);
+  assert(validGlyphs(tr, a) && validGlyphs(tr, b));
+}
+
+void test_multiPage()
+{
+  TestRenderer tr{1024};
+  Renderer& ren = tr;
+  Font a{40}, b{48};
+  addGlyphs(a, 0x100, 60, 40);
+  addGlyphs(b, 0x200, 60, 48);
+
+  {
+    FontAtlas atlas;
+    atlas.add(a);
+    atlas.add(b);
+    assert(atlas.make(ren, 128));
+    assert(atlas.pages() > 1);
+    for (int i = 0; i < atlas.pages(); ++i) {
+      assert(atlas.pageWidth(i) <= 128 && atlas.pageHeight(i) <= 128);
+    }
+    assert(validGlyphs(tr, a) && validGlyphs(tr, b));
+    assert(a.atlasPages() + b.atlasPages() >= atlas.pages());
+
+  }
+
+  // fonts keep their pages after atlas is destroyed
+  assert(validGlyphs(tr, a) && validGlyphs(tr, b));
+
+  // glyph too large for page
+  FontAtlas small;
+  small.add(a);
+  assert(!small.make(ren, 32));
+
+  // pages that can't fit every glyph are trimmed to packed height
+  // (40x40 glyphs, one per 64x64 page)
+  Font c{40};
+  for (int code : {1039, 1079, 1119}) { addGlyphs(c, code, 1, 40); }
+  FontAtlas atlas;
+  atlas.add(c);
+  assert(atlas.make(ren, 64));
+  assert(atlas.pages() == 3);
+  for (int i = 0; i < atlas.pages(); ++i) {
+    assert(atlas.pageWidth(i) <= 64 && atlas.pageHeight(i) == 48);
+  }
+  assert(validGlyphs(tr, c));
+}
+
+void test_sdfAndPacked()
+{
+  TestRenderer tr{1024};
+  Renderer& ren = tr;
+  Font a{16};
+  addGlyphs(a, 'A', 26, 16);
+
+  // prepacked SDF font
+  uint8_t pixels[16 * 8] = {};
+  for (int y = 1; y < 8; ++y) {
+    for (int x = 9; x < 15; ++x) { pixels[(y * 16) + x] = 'Z'; }
+  }
+  const GlyphStaticData glyphs[] = {
+    {' ', 0, 0, 0, 0, 4, 0, nullptr, 0, 0},
+    {'Z', 6, 7, 1, 7, 8, 0, nullptr, 9, 1}};
+  Font s;
+  assert(s.loadFromData({12, glyphs, 2, pixels, 16, 8, true}));
+  s.setKeepBitmaps(false);
+
+  FontAtlas atlas;
+  atlas.add(a);
+  atlas.add(s);
+  assert(atlas.make(ren));
+
+  // SDF glyphs use separate page w/ SDF shader
+  assert(atlas.pages() == 2);
+  assert(a.atlas().id() != s.atlas().id());
+  assert(!tr.textures.at(a.atlas().id()).params.sdf);
+  assert(tr.textures.at(s.atlas().id()).params.sdf);
+  assert(validGlyphs(tr, a) && validGlyphs(tr, s));
+  assert(s.findGlyph('Z')->bitmap == nullptr && s.bitmapBytes() == 0);
+  assert(a.findGlyph('A')->bitmap != nullptr);
+
+  // bitmaps released, atlas can't be made again
+  assert(!atlas.make(ren));
+}
+
+int main(int argc, char** argv)
+{
+  test_sharedPage();
+  test_multiPage();
+  test_sdfAndPacked();
+  return 0;
+}
@@ -0,0 +1,228 @@
+//
+// FontTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "gx/Font.hh"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <cassert>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+void addGlyph(Font& f, int code, float advX)
+{
+  f.addGlyph(code, 0, 0, 0, 0, advX, 0, nullptr, false);
+}
+
+void test_findGlyph()
+{
+  Font f{16};
+  assert(f.empty());
+  assert(f.findGlyph('A') == nullptr);
+  assert(f.findGlyph(-1) == nullptr);
+
+  // direct index (BMP) & hashed codes
+  for (int c = 32; c < 127; ++c) { addGlyph(f, c, float(c)); }
+  addGlyph(f, 0x4e00, 1);
+  for (int c = 0x1f600; c < 0x1f700; ++c) { addGlyph(f, c, float(c)); }
+  addGlyph(f, -5, 2);
+
+  const Glyph* a = f.findGlyph('A');
+  assert(a != nullptr && a->code == 'A' && a->advX == float('A'));
+  assert(f.findGlyph(0x4e00)->code == 0x4e00);
+  assert(f.findGlyph(0x4e01) == nullptr);
+  assert(f.findGlyph(0x1f680)->advX == float(0x1f680));
+  assert(f.findGlyph(0x1f700) == nullptr);
+  assert(f.findGlyph(-5)->advX == 2);
+  assert(f.glyphs().size() == 95 + 1 + 256 + 1);
+
+  // glyph pointers stay valid as glyphs are added
+  for (int c = 0x400; c < 0x2000; ++c) { addGlyph(f, c, 0); }
+  assert(f.findGlyph('A') == a);
+
+  // adding existing code replaces glyph values
+  addGlyph(f, 'A', 99);
+  assert(f.findGlyph('A') == a && a->advX == 99);
+}
+
+void test_unknownGlyph()
+{
+  Font f{16};
+  assert(f.findGlyphOrUnknown('x') == nullptr);
+
+  addGlyph(f, 'x', 1);
+  addGlyph(f, '*', 2);
+  assert(f.findGlyphOrUnknown('x')->code == 'x');
+  assert(f.findGlyphOrUnknown(0x10ffff)->code == '*');
+
+  f.setUnknownCode('x');
+  assert(f.findGlyphOrUnknown('y')->code == 'x');
+  f.setUnknownCode('?');
+  assert(f.findGlyphOrUnknown('y') == nullptr);
+  addGlyph(f, '?', 3);
+  assert(f.findGlyphOrUnknown('y')->code == '?');
+}
+
+void test_bitmaps()
+{
+  Font f{16};
+  uint8_t buf[64 * 64];
+  for (int i = 0; i < 1000; ++i) {
+    buf[0] = uint8_t(i);
+    f.addGlyph(0x3000 + i, 1 + (i % 64), 64, 0, 0, 1, 0, buf, true);
+  }
+  assert(f.bitmapBytes() >= std::size_t(32 * 64 * 1000));
+
+  // copied bitmaps don't change w/ source, static bitmaps aren't copied
+  for (int i = 0; i < 1000; ++i) {
+    const Glyph* g = f.findGlyph(0x3000 + i);
+    assert(g->bitmap[0] == uint8_t(i) && g->width == 1 + (i % 64));
+    assert(g->image().data() == g->bitmap);
+  }
+
+  const std::size_t bytes = f.bitmapBytes();
+  f.addGlyph('x', 64, 64, 0, 0, 1, 0, buf, false);
+  assert(f.findGlyph('x')->bitmap == buf && f.bitmapBytes() == bytes);
+
+  // glyph w/o bitmap is empty
+  f.addGlyph('y', 8, 8, 0, 0, 1, 0, nullptr, true);
+  assert(f.findGlyph('y')->empty() && !f.findGlyph('x')->empty());
+}
+
+void test_staticData()
+{
+  // 2 glyphs packed in 16x8 atlas
+  static const uint8_t atlas[16 * 8] = {};
+  static const GlyphStaticData glyphs[] = {
+    {' ', 0, 0, 0, 0, 4, 0, nullptr, 0, 0},
+    {'A', 6, 7, 1, 7, 8, 0, nullptr, 9, 1}};
+  const FontStaticData data{12, glyphs, 2, atlas, 16, 8};
+
+  Font f;
+  assert(f.loadFromData(data));
+  assert(f.size() == 12 && f.glyphs().size() == 2);
+  const Glyph* a = f.findGlyph('A');
+  assert(a->width == 6 && a->height == 7 && a->advX == 8);
+  assert(a->bitmap == nullptr && !a->empty());
+  assert(a->t0.x == 9.0f / 16.0f && a->t0.y == 1.0f / 8.0f);
+  assert(a->t1.x == 15.0f / 16.0f && a->t1.y == 1.0f);
+  assert(f.findGlyph(' ')->empty());
+
+  assert(!f.sdf() && f.glyphPadding() == 0 && f.glyphWidth('A') == 8);
+
+  // static data only loads into an empty font
+  assert(!f.loadFromData(data));
+
+  // SDF glyph padding isn't included in glyph width
+  const FontStaticData sdfData{12, glyphs, 2, atlas, 16, 8, true};
+  Font f2;
+  assert(f2.loadFromData(sdfData));
+  assert(f2.sdf() && f2.glyphPadding() == float(Font::SDF_SPREAD));
+  assert(f2.glyphWidth('A') == 8 && f2.glyphWidth(' ') == 4);
+}
+
+[[nodiscard]] std::vector<char> readFile(const std::string& fileName)
+{
+  std::ifstream fs{fileName, std::ios::binary};
+  return {std::istreambuf_iterator<char>{fs}, {}};
+}
+
+void writeFile(const std::string& fileName, const std::vector<char>& data)
+{
+  std::ofstream fs{fileName, std::ios::binary | std::ios::trunc};
+  fs.write(data.data(), std::streamsize(data.size()));
+}
+
+void test_cache(const std::string& fontFile)
+{
+  const std::string cacheFile =
+    (std::filesystem::temp_directory_path() / "gx_FontTest.cache").string();
+  std::filesystem::remove(cacheFile);
+
+  Font f{20};
+  assert(f.load(fontFile));
+  assert(f.saveCache(cacheFile));
+
+  // round trip
+  Font c{20};
+  assert(c.loadCache(cacheFile, fontFile));
+  assert(c.glyphs().size() == f.glyphs().size());
+  for (const Glyph& g : f.glyphs()) {
+    const Glyph* x = c.findGlyph(g.code);
+    assert(x != nullptr && x->bitmap == nullptr);
+    assert(x->width == g.width && x->height == g.height);
+    assert(x->left == g.left && x->top == g.top);
+    assert(x->advX == g.advX && x->advY == g.advY);
+    assert(x->empty() == g.empty());
+  }
+  assert(c.ymin() == f.ymin() && c.ymax() == f.ymax());
+
+  // cached font can't be saved, cache only loads into an empty font
+  assert(!c.saveCache(cacheFile));
+  assert(!c.loadCache(cacheFile, fontFile));
+
+  // lazy font can't be saved
+  Font lz{20};
+  lz.setLazy(true);
+  assert(lz.load(fontFile) && !lz.saveCache(cacheFile));
+
+  // size, SDF mode & font file contents must match
+  Font s{21};
+  assert(!s.loadCache(cacheFile, fontFile) && s.empty());
+  Font sdf{20};
+  sdf.setSDF(true);
+  assert(!sdf.loadCache(cacheFile, fontFile) && sdf.empty());
+  Font h{20};
+  assert(!h.loadCache(cacheFile, cacheFile) && h.empty());
+  assert(!h.loadCache(cacheFile + ".missing", fontFile) && h.empty());
+
+  const std::vector<char> data = readFile(cacheFile);
+  assert(data.size() > 16);
+
+  // format version mismatch
+  std::vector<char> v = data;
+  ++v[4];
+  writeFile(cacheFile, v);
+  Font fv{20};
+  assert(!fv.loadCache(cacheFile, fontFile) && fv.empty());
+
+  // glyph rect outside of atlas
+  // (1st glyph width at offset 44: 40 byte header, 4 byte glyph code)
+  std::vector<char> g = data;
+  g[44] = char(0xff); g[45] = char(0xff);
+  writeFile(cacheFile, g);
+  Font fg{20};
+  assert(!fg.loadCache(cacheFile, fontFile) && fg.empty());
+
+  // truncated file
+  for (std::size_t len : {data.size() - 1, data.size() / 2, std::size_t(8)}) {
+    writeFile(cacheFile, {data.begin(), data.begin() + std::ptrdiff_t(len)});
+    Font ft{20};
+    assert(!ft.loadCache(cacheFile, fontFile) && ft.empty());
+  }
+
+  // unchanged file still loads
+  writeFile(cacheFile, data);
+  Font ok{20};
+  assert(ok.loadCache(cacheFile, fontFile));
+
+  std::filesystem::remove(cacheFile);
+}
+
+int main(int argc, char** argv)
+{
+  test_findGlyph();
+  test_unknownGlyph();
+  test_bitmaps();
+  test_staticData();
+  test_cache((argc > 1) ? argv[1] : "data/FreeSans.ttf");
+  return 0;
+}
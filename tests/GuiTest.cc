@@ -0,0 +1,382 @@
+//
+// GuiTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+// headless Gui tests (uses window-less Gui::update())
+//
+
+#include "gx/Gui.hh"
+#include "gx/GuiBuilder.hh"
+#include "gx/GuiTheme.hh"
+#include "gx/EventState.hh"
+#include "gx/Font.hh"
+#include <random>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cassert>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+constexpr int WIDTH = 1920;
+constexpr int HEIGHT = 1080;
+
+void update(Gui& gui)
+{
+  EventState es{};
+  es.focused = true;
+  gui.update(es, 0, WIDTH, HEIGHT);
+}
+
+class TestInput
+{
+  // sends mouse/key events to Gui (one update per event)
+ public:
+  explicit TestInput(Gui& gui) : _gui{gui} { }
+
+  void move(Vec2 pt) {
+    send(EVENT_MOUSE_MOVE, pt, _buttonHeld ? 1 : -1); }
+  void press(Vec2 pt) {
+    _buttonHeld = true;
+    send(EVENT_INPUT, pt, 1); }
+  void release(Vec2 pt) {
+    _buttonHeld = false;
+    send(EVENT_INPUT, pt, 0); }
+  void click(Vec2 pt) { move(pt); press(pt); release(pt); }
+  void scroll(Vec2 pt, float dy) {
+    init(EVENT_MOUSE_MOVE | EVENT_MOUSE_SCROLL, pt).scrollPt = {0, dy};
+    _gui.update(_es, _es.events, WIDTH, HEIGHT);
+  }
+
+  void key(InputEnum k, int mods = 0) {
+    EventState& es = init(EVENT_INPUT, _pt);
+    es.mods = mods;
+    es.inputStates.push_back({k, 0, 1, 0, true});
+    _gui.update(es, es.events, WIDTH, HEIGHT);
+    init(EVENT_INPUT, _pt).inputStates.push_back({k, 0, 0, 0, false});
+    _gui.update(_es, _es.events, WIDTH, HEIGHT);
+  }
+
+  void text(std::string_view txt) {
+    init(EVENT_TEXT, _pt).text = txt;
+    _gui.update(_es, _es.events, WIDTH, HEIGHT);
+  }
+
+ private:
+  Gui& _gui;
+  EventState _es{};
+  Vec2 _pt{};
+  int64_t _time = 0;
+  bool _buttonHeld = false;
+
+  EventState& init(int events, Vec2 pt) {
+    _time += 10000;
+    _pt = pt;
+    _es = {};
+    _es.lastPollTime = _time;
+    _es.mousePt = pt;
+    _es.events = events;
+    _es.mouseIn = true;
+    _es.focused = true;
+    return _es;
+  }
+
+  void send(int events, Vec2 pt, int button) {
+    // button: 1 pressed/held, 0 released, -1 no button state
+    EventState& es = init(events, pt);
+    if (button >= 0) {
+      es.inputStates.push_back(
+        {BUTTON_1, 0, uint8_t(events == EVENT_INPUT && button), 0,
+         bool(button)});
+    }
+    _gui.update(es, es.events, WIDTH, HEIGHT);
+  }
+};
+
+
+// **** Layout ****
+struct TreeNode {
+  GuiElemType type;
+  Align align;
+  EventID id;
+  std::vector<TreeNode> children{};
+};
+
+std::string randomText(std::mt19937& rg)
+{
+  static constexpr std::string_view chars = "iWx mM.\n";
+  std::string s(rg() % 12, ' ');
+  for (char& ch : s) { ch = chars[rg() % chars.size()]; }
+  return s;
+}
+
+TreeNode randomTree(std::mt19937& rg, int depth, EventID& lastID,
+                    std::vector<std::string>& text,
+                    std::vector<EventID>& labels)
+{
+  static constexpr Align aligns[] = {
+    Align::top_left, Align::center, Align::bottom_right, Align::justify,
+    Align::hjustify, Align::vjustify};
+
+  const Align align = aligns[rg() % std::size(aligns)];
+  const EventID id = ++lastID;
+  text.resize(std::size_t(id) + 1);
+  if (depth == 0 || (rg() % 3) == 0) {
+    text[std::size_t(id)] = randomText(rg);
+    labels.push_back(id);
+    return {GUI_LABEL, align, id};
+  }
+
+  TreeNode n{(rg() & 1) ? GUI_HFRAME : GUI_VFRAME, align, id};
+  const int count = 1 + int(rg() % 4);
+  for (int i = 0; i < count; ++i) {
+    n.children.push_back(randomTree(rg, depth - 1, lastID, text, labels));
+  }
+  return n;
+}
+
+GuiElem makeElem(const TreeNode& n, const std::vector<std::string>& text)
+{
+  if (n.type == GUI_LABEL) {
+    return guiLabel(n.id, n.align, text[std::size_t(n.id)]);
+  }
+
+  GuiElem e{n.type, n.align, n.id};
+  for (const TreeNode& c : n.children) { e.elems.push_back(makeElem(c, text)); }
+  return e;
+}
+
+void test_layout(const GuiTheme& thm)
+{
+  // incremental layout after setText() must match layout of a new panel
+  constexpr float X = WIDTH / 2, Y = HEIGHT / 2;
+  constexpr Align panelAligns[] = {
+    Align::top_left, Align::center, Align::bottom_right};
+
+  std::mt19937 rg{1234};
+  for (int t = 0; t < 200; ++t) {
+    EventID lastID = 0;
+    std::vector<std::string> text;
+    std::vector<EventID> labels;
+    const TreeNode root = randomTree(rg, 4, lastID, text, labels);
+    const Align pa = panelAligns[t % std::size(panelAligns)];
+
+    Gui gui;
+    const PanelID pid = gui.newPanel(thm, X, Y, pa, 0, makeElem(root, text));
+    update(gui);
+
+    for (int edit = 0; edit < 30; ++edit) {
+      const EventID id = labels[rg() % labels.size()];
+      text[std::size_t(id)] = randomText(rg);
+      assert(gui.setText(pid, id, text[std::size_t(id)]));
+      update(gui);
+
+      Gui ref;
+      const PanelID rid = ref.newPanel(thm, X, Y, pa, 0, makeElem(root, text));
+      update(ref);
+
+      Rect r1, r2;
+      assert(gui.getPanelLayout(pid, r1) && ref.getPanelLayout(rid, r2));
+      assert(r1.x == r2.x && r1.y == r2.y && r1.w == r2.w && r1.h == r2.h);
+      for (EventID i = 1; i <= lastID; ++i) {
+        assert(gui.getElemLayout(pid, i, r1) && ref.getElemLayout(rid, i, r2));
+        assert(r1.x == r2.x && r1.y == r2.y && r1.w == r2.w && r1.h == r2.h);
+      }
+    }
+  }
+}
+
+
+
+// **** Mouse hit testing ****
+void test_hit(const GuiTheme& thm)
+{
+  // hit grid must find the same element as a search of element layouts
+  // (dense panel of buttons w/ random sizes & label gaps)
+  std::mt19937 rg{5678};
+  std::vector<std::string> text;
+  GuiElem grid = guiVFrame();
+  EventID lastID = 0;
+  for (int row = 0; row < 30; ++row) {
+    GuiElem line = guiHFrame((row & 1) ? Align::justify : Align::top_left);
+    for (int col = 0; col < 20; ++col) {
+      const std::string txt = randomText(rg);
+      if ((rg() % 5) == 0) {
+        line.elems.push_back(guiLabel(txt));
+      } else {
+        line.elems.push_back(guiButton(++lastID, txt));
+      }
+    }
+    grid.elems.push_back(std::move(line));
+  }
+
+  Gui gui;
+  const PanelID pid = gui.newPanel(thm, 10, 10, Align::top_left, 0,
+                                   std::move(grid));
+  update(gui);
+
+  std::vector<Rect> buttons;
+  float maxX = 0, maxY = 0;
+  for (EventID i = 1; i <= lastID; ++i) {
+    Rect& r = buttons.emplace_back();
+    assert(gui.getElemLayout(pid, i, r));
+    maxX = std::max(maxX, r.x + r.w);
+    maxY = std::max(maxY, r.y + r.h);
+  }
+
+  TestInput in{gui};
+  int hits = 0;
+  for (int i = 0; i < 4000; ++i) {
+    // points also sampled outside of panel
+    const Vec2 pt{float(rg() % int(maxX + 20)) + .5f,
+                  float(rg() % int(maxY + 20)) + .5f};
+    EventID expected = 0;
+    for (std::size_t b = 0; b < buttons.size(); ++b) {
+      const Rect& r = buttons[b];
+      if (pt.x >= r.x && pt.x < (r.x + r.w)
+          && pt.y >= r.y && pt.y < (r.y + r.h)) {
+        expected = EventID(b + 1);
+        break;
+      }
+    }
+
+    in.click(pt);
+    assert(gui.event().eid == expected);
+    hits += (expected != 0);
+  }
+  assert(hits > 500);
+}
+
+// **** GUI_LIST ****
+void test_list(const GuiTheme& thm)
+{
+  constexpr EventID ID = 1;
+  Gui gui;
+  const PanelID pid = gui.newPanel(thm, 10, 10, Align::top_left, 0,
+    guiList(ID, 20, 10, 1000, [](int row, std::string& out) {
+      out = std::to_string(row); }));
+  update(gui);
+
+  Rect r;
+  assert(gui.getElemLayout(pid, ID, r));
+  const auto rowPt = [&r](int row) {
+    return Vec2{r.x + (r.w * .3f), r.y + (r.h * ((float(row) + .5f) / 10))};
+  };
+
+  TestInput in{gui};
+  const auto clickRow = [&](int row) {
+    // returns selected row from press event (-1 if no event)
+    // (no move event first so press is the 1st update after any change)
+    in.press(rowPt(row));
+    const GuiEvent ev = gui.event();
+    in.release(rowPt(row));
+    return ev ? ev.item_no : -1;
+  };
+
+  assert(clickRow(3) == 3 && gui.getItemNo(pid, ID) == 3);
+
+  // scrollbar drag continues when pointer moves left of scrollbar
+  in.move({r.x + r.w - 3, r.y + 5});
+  in.press({r.x + r.w - 3, r.y + 5});
+  in.move({r.x + (r.w * .3f), r.y + (r.h * .5f)});
+  in.move({r.x + (r.w * .3f), r.y + r.h - 2});
+  in.release({r.x + (r.w * .3f), r.y + r.h - 2});
+  assert(clickRow(0) == 990);
+
+  // shrinking list clamps scroll & clears selection past new end
+  assert(gui.setListRows(pid, ID, 20));
+  assert(gui.getItemNo(pid, ID) == -1);
+  assert(clickRow(0) == 10 && clickRow(9) == 19);
+
+  assert(gui.setListRows(pid, ID, 5));
+  assert(gui.getItemNo(pid, ID) == -1);
+  assert(clickRow(0) == 0 && clickRow(4) == 4 && clickRow(7) == -1);
+  assert(gui.setListRows(pid, ID, 5) && gui.getItemNo(pid, ID) == 4);
+
+  in.scroll(rowPt(0), -10);
+  assert(clickRow(0) == 0);
+}
+
+// **** GUI_TEXTEDIT ****
+void test_textEdit(const GuiTheme& thm)
+{
+  constexpr EventID ID = 1;
+  Gui gui;
+  const PanelID pid = gui.newPanel(thm, 10, 10, Align::top_left, 0,
+    guiTextEdit(ID, 20, 5, "hello world\nsecond line"));
+  update(gui);
+
+  Rect r;
+  assert(gui.getElemLayout(pid, ID, r));
+  const Vec2 start{r.x + 3, r.y + 3};
+  const auto text = [&]{ return gui.getText(pid, ID); };
+
+  TestInput in{gui};
+  in.click(start);
+  in.key(KEY_HOME, MODIFIER_CTRL);
+  in.text("Say");
+  assert(text() == "Sayhello world\nsecond line");
+
+  // double click selects word (word spans 2 text pieces)
+  in.move(start);
+  in.press(start);
+  in.release(start);
+  in.press(start);
+  in.release(start);
+  in.text("Hi");
+  assert(text() == "Hi world\nsecond line");
+
+  in.key(KEY_END, MODIFIER_CTRL);
+  in.key(KEY_ENTER);
+  in.text("third");
+  assert(text() == "Hi world\nsecond line\nthird");
+
+  in.key(KEY_HOME, MODIFIER_SHIFT);
+  in.text("3rd");
+  assert(text() == "Hi world\nsecond line\n3rd");
+
+  in.key(KEY_UP);
+  in.key(KEY_HOME);
+  in.key(KEY_END, MODIFIER_SHIFT);
+  in.key(KEY_BACKSPACE);
+  assert(text() == "Hi world\n\n3rd");
+  in.key(KEY_BACKSPACE);
+  assert(text() == "Hi world\n3rd");
+  in.key(KEY_DELETE);
+  assert(text() == "Hi world3rd");
+
+  for (int i = 0; i < 3; ++i) { in.key(KEY_LEFT, MODIFIER_SHIFT); }
+  in.key(KEY_DELETE);
+  assert(text() == "Hi wo3rd");
+
+  // UTF-8 character erase & tab
+  in.key(KEY_A, MODIFIER_CTRL);
+  in.text("a\xC3\xA9z");
+  in.key(KEY_LEFT);
+  in.key(KEY_BACKSPACE);
+  assert(text() == "az");
+  in.key(KEY_TAB);
+  assert(text() == "a  z");
+
+  in.key(KEY_A, MODIFIER_CTRL);
+  in.key(KEY_BACKSPACE);
+  assert(text().empty());
+}
+
+int main(int argc, char** argv)
+{
+  const char* fontFile = (argc > 1) ? argv[1] : "data/FreeSans.ttf";
+  Font fnt{20};
+  if (!fnt.load(fontFile)) { return -1; }
+  const GuiTheme thm{&fnt};
+
+  test_layout(thm);
+  test_hit(thm);
+  test_list(thm);
+  test_textEdit(thm);
+  return 0;
+}
@@ -0,0 +1,162 @@
+//
+// PathTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "gx/Path.hh"
+#include "gx/MathUtil.hh"
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <initializer_list>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+float triangleArea(const std::vector<Vec2>& tri)
+{
+  // total area of triangle list (all triangles must have same winding)
+  float total = 0;
+  for (std::size_t i = 0; i < tri.size(); i += 3) {
+    const Vec2 a = tri[i], b = tri[i+1], c = tri[i+2];
+    total += ((b.x - a.x) * (c.y - a.y)) - ((b.y - a.y) * (c.x - a.x));
+  }
+  return std::abs(total) * .5f;
+}
+
+void test_square()
+{
+  Path p;
+  p.moveTo({0,0});
+  p.lineTo({10,0});
+  p.lineTo({10,10});
+  p.lineTo({0,10});
+  p.close();
+
+  assert(p.contours().size() == 1);
+  assert(p.contours()[0].closed);
+  assert(p.contours()[0].points.size() == 4);
+  assert(p.triangles().size() == 6);
+  assert(isEq(triangleArea(p.triangles()), 100.0f));
+}
+
+void test_concave()
+{
+  // L shape
+  Path p;
+  p.moveTo({0,0});
+  p.lineTo({10,0});
+  p.lineTo({10,4});
+  p.lineTo({4,4});
+  p.lineTo({4,10});
+  p.lineTo({0,10});
+  p.close();
+
+  assert(p.triangles().size() == 12);
+  assert(isEq(triangleArea(p.triangles()), 64.0f));
+}
+
+void test_hole()
+{
+  // square w/ square hole (same winding for both contours)
+  Path p;
+  p.moveTo({0,0});
+  p.lineTo({10,0});
+  p.lineTo({10,10});
+  p.lineTo({0,10});
+  p.close();
+  p.moveTo({3,3});
+  p.lineTo({7,3});
+  p.lineTo({7,7});
+  p.lineTo({3,7});
+  p.close();
+
+  assert(p.contours().size() == 2);
+  assert(isEq(triangleArea(p.triangles()), 84.0f));
+
+  // island inside hole
+  p.moveTo({4,4});
+  p.lineTo({6,4});
+  p.lineTo({6,6});
+  p.lineTo({4,6});
+  p.close();
+  assert(isEq(triangleArea(p.triangles()), 88.0f));
+}
+
+void test_curves()
+{
+  // circle from 4 cubic curves
+  constexpr float k = .5522847f * 100.0f;
+  Path p;
+  p.moveTo({100,0});
+  p.cubicTo({100,k}, {k,100}, {0,100});
+  p.cubicTo({-k,100}, {-100,k}, {-100,0});
+  p.cubicTo({-100,-k}, {-k,-100}, {0,-100});
+  p.cubicTo({k,-100}, {100,-k}, {100,0});
+  p.close();
+
+  const auto& c = p.contours();
+  assert(c.size() == 1);
+  const std::size_t n = c[0].points.size();
+  assert(n > 16);
+  for (const Vec2& pt : c[0].points) {
+    assert(std::abs(pt.length() - 100.0f) < .5f);
+  }
+
+  // triangulation area close to circle area
+  const float area = triangleArea(p.triangles());
+  assert(std::abs(area - (PI<float> * 10000.0f)) < 100.0f);
+
+  // smaller tolerance gives more points & invalidates cache
+  p.setTolerance(.01f);
+  assert(p.contours()[0].points.size() > n);
+
+  // quadratic curve end points
+  Path q;
+  q.moveTo({0,0});
+  q.quadTo({50,100}, {100,0});
+  assert(!q.contours()[0].closed);
+  assert(q.contours()[0].points.back() == Vec2(100,0));
+}
+
+void test_copy()
+{
+  auto p = std::make_unique<Path>();
+  p->moveTo({0,0});
+  p->lineTo({10,0});
+  p->lineTo({0,10});
+  p->close();
+  assert(p->contours().size() == 1);
+
+  // copy has own flattened data
+  Path c1{*p}, c2;
+  c2 = *p;
+  p->clear();
+  p->moveTo({5,5});
+  p->lineTo({6,5});
+  (void)p->contours();
+  p.reset();
+  for (const Path* c : {&c1, &c2}) {
+    assert(c->contours().size() == 1);
+    assert(c->contours()[0].points.size() == 3);
+    assert(c->contours()[0].points[1] == Vec2(10,0));
+  }
+
+  // moved path keeps cache
+  const Vec2* pts = c1.contours()[0].points.data();
+  Path m{std::move(c1)};
+  assert(m.contours()[0].points.data() == pts);
+}
+
+int main(int argc, char** argv)
+{
+  test_square();
+  test_concave();
+  test_hole();
+  test_curves();
+  test_copy();
+  return 0;
+}
@@ -0,0 +1,150 @@
+//
+// TextBufferTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "gx/TextBuffer.hh"
+#include <random>
+#include <cassert>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+void checkLines(const TextBuffer& tb, const std::string& txt)
+{
+  // compare line index against text scan
+  std::size_t line = 0, start = 0;
+  for (std::size_t i = 0; i <= txt.size(); ++i) {
+    if (i == txt.size() || txt[i] == '\n') {
+      assert(tb.lineStart(line) == start);
+      assert(tb.lineEnd(line) == i);
+      ++line; start = i + 1;
+    }
+  }
+  assert(tb.lines() == line);
+}
+
+void test_edit()
+{
+  TextBuffer tb{"hello\nworld"};
+  assert(tb.size() == 11);
+  assert(tb.lines() == 2);
+  assert(tb.lineOf(5) == 0);
+  assert(tb.lineOf(6) == 1);
+
+  std::string line;
+  tb.getLine(1, line);
+  assert(line == "world");
+
+  tb.insert(5, ",\nbig");
+  assert(tb.text() == "hello,\nbig\nworld");
+  checkLines(tb, tb.text());
+
+  tb.erase(3, 6);
+  assert(tb.text() == "helg\nworld");
+  checkLines(tb, tb.text());
+
+  // typing at end extends last piece
+  tb.insert(tb.size(), "!");
+  const std::size_t n = tb.pieces();
+  tb.insert(tb.size(), "!");
+  assert(tb.pieces() == n);
+  assert(tb.text() == "helg\nworld!!");
+
+  tb.erase(0, 1000);
+  assert(tb.empty() && tb.lines() == 1 && tb.pieces() == 0);
+}
+
+void test_utf8()
+{
+  TextBuffer tb{"a\xC3\xA9z"}; // a, e-acute, z
+  assert(tb.nextChar(1) == 3);
+  assert(tb.prevChar(3) == 1);
+  assert(tb.prevChar(1) == 0);
+  assert(tb.nextChar(4) == 4);
+}
+
+void test_random()
+{
+  // random edits compared against std::string
+  std::mt19937 rg{1234};
+  std::string ref = "line one\nline two\n\nline four";
+  TextBuffer tb{ref};
+  std::string txt;
+  for (int i = 0; i < 2000; ++i) {
+    const std::size_t pos = std::size_t(rg() % (ref.size() + 1));
+    if ((rg() % 3) != 0) {
+      const std::string ins = (rg() & 1) ? "ab\ncd" : "x";
+      ref.insert(pos, ins);
+      tb.insert(pos, ins);
+    } else {
+      const std::size_t len = std::size_t(rg() % 8);
+      ref.erase(pos, len);
+      tb.erase(pos, len);
+    }
+    assert(tb.size() == ref.size());
+    if ((i % 50) == 0) {
+      assert(tb.text() == ref);
+      checkLines(tb, ref);
+    }
+  }
+  assert(tb.text() == ref);
+  checkLines(tb, ref);
+
+  tb.getText(3, 10, txt);
+  assert(txt == ref.substr(3, 10));
+}
+
+void test_blocks()
+{
+  // scattered edits of a large buffer (pieces split across many blocks)
+  std::mt19937 rg{5678};
+  std::string ref;
+  for (int i = 0; i < 2000; ++i) {
+    ref += "line " + std::to_string(i) + " of text\n";
+  }
+  TextBuffer tb{ref};
+  for (int i = 0; i < 6000; ++i) {
+    const std::size_t pos = std::size_t(rg() % (ref.size() + 1));
+    if ((rg() % 4) != 0) {
+      const std::string ins = (rg() & 1) ? "ab\ncd" : "x";
+      ref.insert(pos, ins);
+      tb.insert(pos, ins);
+    } else {
+      const std::size_t len = std::size_t(rg() % 40);
+      ref.erase(pos, len);
+      tb.erase(pos, len);
+    }
+    assert(tb.size() == ref.size());
+  }
+  assert(tb.pieces() > 1000);
+  assert(tb.text() == ref);
+  checkLines(tb, ref);
+
+  const std::string_view sv = ref;
+  std::size_t line = 0;
+  for (std::size_t pos = 0; pos <= ref.size(); ++pos) {
+    assert(tb.lineOf(pos) == line);
+    if (pos < ref.size() && ref[pos] == '\n') { ++line; }
+
+    const std::string_view c1 = tb.chunkAt(pos);
+    assert((pos == ref.size()) == c1.empty());
+    assert(c1 == sv.substr(pos, c1.size()));
+
+    const std::string_view c2 = tb.chunkBefore(pos);
+    assert((pos == 0) == c2.empty());
+    assert(c2.size() <= pos && c2 == sv.substr(pos - c2.size(), c2.size()));
+  }
+}
+
+int main(int argc, char** argv)
+{
+  test_edit();
+  test_utf8();
+  test_random();
+  test_blocks();
+  return 0;
+}
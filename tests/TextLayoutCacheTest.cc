@@ -0,0 +1,79 @@
+//
+// TextLayoutCacheTest.cc
+// Copyright (C) 2026 Richard Bradley
+//
+
+#include "gx/TextLayoutCache.hh"
+#include "gx/Font.hh"
+#include <optional>
+#include <cassert>
+using namespace gx;
+
+#ifdef NDEBUG
+#error "can't run test with NDEBUG"
+#endif
+
+
+void addGlyphs(Font& f, float advX)
+{
+  for (int c = 32; c < 127; ++c) {
+    f.addGlyph(c, 0, 0, 0, 0, advX, 0, nullptr, false);
+  }
+}
+
+void test_hits()
+{
+  Font f{16};
+  addGlyphs(f, 10);
+  TextLayoutCache cache;
+  const TextFormat tf{.font = &f};
+  assert(cache.calcProperties(tf, "abc").width == 30);
+  assert(cache.calcProperties(tf, "abc").width == 30);
+  assert(cache.calcProperties(tf, "ab").width == 20);
+  assert(cache.hits() == 1 && cache.misses() == 2 && cache.size() == 2);
+
+  cache.clear();
+  assert(cache.size() == 0);
+  assert(cache.calcProperties(tf, "abc").width == 30);
+  assert(cache.misses() == 3);
+}
+
+void test_fontChange()
+{
+  // entries of a destroyed font aren't used by a new font at same address
+  std::optional<Font> f;
+  f.emplace(16);
+  addGlyphs(*f, 10);
+  const Font* fp = &*f;
+  TextLayoutCache cache;
+  TextFormat tf{.font = fp};
+  assert(cache.calcProperties(tf, "abc").width == 30);
+
+  f.reset();
+  f.emplace(16);
+  addGlyphs(*f, 5);
+  assert(&*f == fp);
+  assert(cache.calcProperties(tf, "abc").width == 15);
+  assert(cache.hits() == 0);
+
+  // changed glyph
+  f->addGlyph('a', 0, 0, 0, 0, 20, 0, nullptr, false);
+  assert(cache.calcProperties(tf, "abc").width == 30);
+
+  // font moved to/from
+  const uint64_t s = f->serial();
+  Font f2{std::move(*f)};
+  assert(f2.serial() == s && f->serial() != s);
+  addGlyphs(*f, 1);
+  assert(cache.calcProperties(tf, "abc").width == 3);
+  tf.font = &f2;
+  assert(cache.calcProperties(tf, "abc").width == 30);
+  assert(cache.hits() == 1);
+}
+
+int main(int argc, char** argv)
+{
+  test_hits();
+  test_fontChange();
+  return 0;
+}
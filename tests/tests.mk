@@ -3,11 +3,21 @@ INCLUDE_TEST = .
 LIBS_TEST = LIB_gx
 SOURCE_DIR_TEST = tests
 
+TEST_AtlasPacker.SRC = AtlasPackerTest.cc
 TEST_CmdLineParser.SRC = CmdLineParserTest.cc
 TEST_Color.SRC = ColorTest.cc
+TEST_DrawList.SRC = DrawListTest.cc
+TEST_Font.SRC = FontTest.cc
+TEST_Font.ARGS = data/FreeSans.ttf
+TEST_FontAtlas.SRC = FontAtlasTest.cc
+TEST_Gui.SRC = GuiTest.cc
+TEST_Gui.ARGS = data/FreeSans.ttf
 TEST_GuiBuilder.SRC = GuiBuilderTest.cc
 TEST_MathUtil.SRC = MathUtilTest.cc
 TEST_Normal.SRC = NormalTest.cc
+TEST_Path.SRC = PathTest.cc
 TEST_StringUtil.SRC = StringUtilTest.cc
+TEST_TextBuffer.SRC = TextBufferTest.cc
+TEST_TextLayoutCache.SRC = TextLayoutCacheTest.cc
 TEST_Unicode.SRC = UnicodeTest.cc
 TEST_Vector3D.SRC = Vector3DTest.cc